@@ -22,9 +22,6 @@ class PowerIteratorConan(ConanFile):
     build_requires = ["gtest/1.10.0"]
     generators = ["CMakeToolchain", "cmake_find_package_multi"]
 
-    def requirements(self):
-        self.requires("memoized_member/1.2@{}/{}".format(self.user, self.channel))
-
     def package(self):
         self.copy("*.hpp")
 
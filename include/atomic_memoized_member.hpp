@@ -0,0 +1,104 @@
+/**
+*	\author    John Szwast
+*	\year      2014-2016
+*	\copyright MIT
+*/
+
+
+#pragma once
+
+
+#include <atomic>
+#include <type_traits>
+
+
+/**
+ *	A lazily evaluated, cached member, like MemoizedMember, that const methods of a shared
+ *	object may read from many threads at once without locking.
+ *
+ *	The first read evaluates (owner.*Evaluate)() and publishes the result.  Once published,
+ *	a read is a single acquire load.  No thread ever waits for another: threads that arrive
+ *	while the first evaluation is still running evaluate for themselves and use their own
+ *	result, and the first to finish is the only one to publish.  Evaluate must therefore be a
+ *	pure function of the owner's state, which the memoized counts of combinations and
+ *	powerset are.  If Evaluate throws, nothing is published and the next read tries again.
+ *
+ *	As with MemoizedMember, the owning class passes itself to the constructors, and copying
+ *	or assigning carries over the cached value, not the owner.
+ */
+template<typename R, typename Class, R(Class::*Evaluate)() const>
+class AtomicMemoizedMember
+{
+	static_assert(std::is_trivially_copyable<R>::value, "AtomicMemoizedMember needs a trivially copyable value");
+
+public:
+	AtomicMemoizedMember(Class const& owner)
+		: m_owner(&owner)
+		, m_state(state::empty)
+		, m_value(R{})
+	{
+
+	}
+
+	AtomicMemoizedMember(Class const& owner, AtomicMemoizedMember const& rhs)
+		: m_owner(&owner)
+		, m_state(state::empty)
+		, m_value(R{})
+	{
+		copy_cache(rhs);
+	}
+
+	AtomicMemoizedMember& operator=(AtomicMemoizedMember const& rhs)
+	{
+		if (this != &rhs)
+			copy_cache(rhs);
+		return *this;
+	}
+
+	operator R() const
+	{
+		if (m_state.load(std::memory_order_acquire) == state::ready)
+			return m_value.load(std::memory_order_relaxed);
+		return evaluate();
+	}
+
+private:
+
+	enum class state : unsigned char
+	{
+		empty,
+		publishing,
+		ready
+	};
+
+	R evaluate() const
+	{
+		R const value = (m_owner->*Evaluate)();
+
+		state expected = state::empty;
+		if (m_state.compare_exchange_strong(expected, state::publishing, std::memory_order_relaxed))
+		{
+			m_value.store(value, std::memory_order_relaxed);
+			m_state.store(state::ready, std::memory_order_release);
+		}
+		return value;
+	}
+
+	/// Not thread safe with respect to *this; like any assignment, it needs exclusive access.
+	void copy_cache(AtomicMemoizedMember const& rhs)
+	{
+		if (rhs.m_state.load(std::memory_order_acquire) == state::ready)
+		{
+			m_value.store(rhs.m_value.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			m_state.store(state::ready, std::memory_order_release);
+		}
+		else
+		{
+			m_state.store(state::empty, std::memory_order_relaxed);
+		}
+	}
+
+	Class const* m_owner;
+	mutable std::atomic<state> m_state;
+	mutable std::atomic<R> m_value;
+};
@@ -9,19 +9,31 @@
 
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <memory>
 #include <set>
+#include <stdexcept>
 #include <utility>
 #include <vector>
 
-#include "MemoizedMember.hpp"
+#include "atomic_memoized_member.hpp"
+#include "counting.hpp"
+#include "fingerprint.hpp"
 
 
 using std::rel_ops::operator!=;
 
+/**
+ *	\tparam Source	The container whose elements are combined.  Any container with
+ *		bidirectional const_iterators over Key works; see mapped_records.hpp for one that is
+ *		not a std::set.
+ */
 template<typename Key,
 	class Compare = std::less<Key>,
-	class Allocator = std::allocator<Key>>
+	class Allocator = std::allocator<Key>,
+	class Source = std::set<Key, Compare, Allocator>>
 	class combinations
 {
 public:
@@ -36,12 +48,13 @@ public:
 	using pointer = value_type*;
 	using const_pointer = value_type const*;
 
-	using source_iterator = typename value_type::const_iterator;
+	using source_type = Source;
+	using source_iterator = typename source_type::const_iterator;
 
 	class const_iterator
 	{
 	public:
-		using combinations_type = typename combinations<Key, Compare, Allocator>;
+		using combinations_type = typename combinations<Key, Compare, Allocator, Source>;
 		using source_iterator = typename combinations_type::source_iterator;
 		using mutable_value_type = typename combinations_type::key_type;
 
@@ -62,6 +75,7 @@ public:
 			, m_end(source_end)
 			, m_r(r)
 			, m_members(m_r)
+			, m_rank(0)
 			, m_at_end(end)
 		{
 			source_iterator gopher = m_begin;
@@ -89,12 +103,15 @@ public:
 			m_at_end = m_at_end || (!m_members.empty() && (m_members.back() == m_end));
 		}
 
+		/**
+		 *	Iterators over the same combinations are equal when they have taken the same number
+		 *	of steps from begin, or when both are at end.  Comparing iterators from different
+		 *	combinations objects is undefined, as with standard containers.
+		 */
 		bool operator==(const_iterator const& rhs) const
 		{
-			return (m_begin == rhs.m_begin)
-				&& (m_end == rhs.m_end)
-				&& (m_members == rhs.m_members)
-				&& (m_at_end == rhs.m_at_end);
+			return (m_at_end == rhs.m_at_end)
+				&& (m_at_end || (m_rank == rhs.m_rank));
 		}
 
 		const_iterator& operator++()
@@ -144,6 +161,8 @@ public:
 					(*gopher) = ++reference;
 			}
 
+			++m_rank;
+
 			m_at_end = m_members.empty() || (m_members.back() == m_end);
 		}
 
@@ -151,6 +170,7 @@ public:
 		source_iterator m_end;
 		size_type m_r;	// r as in nCr.  I might not need this, because it is embedded in m_members.
 		std::vector<source_iterator, Allocator> m_members;
+		size_type m_rank;	// Number of increments from begin; the lexicographic rank of the combination.
 		mutable mutable_value_type m_value;	// The value returned by dereferencing.
 		bool m_at_end;	// If m_r == 0, then m_members is always empty and there is no distinction
 							// between begin and end.  This flag will indicate when the end has been reached.
@@ -158,7 +178,7 @@ public:
 
 	using iterator = const_iterator;
 
-	combinations(key_type const& source, size_type r)
+	combinations(source_type const& source, size_type r)
 		: combinations(source.begin(), source.end(), r)
 	{
 
@@ -176,6 +196,8 @@ public:
 		: m_begin(rhs.m_begin)
 		, m_end(rhs.m_end)
 		, m_r(rhs.m_r)
+		, m_source_size(*this, rhs.m_source_size)
+		, m_fingerprint(*this, rhs.m_fingerprint)
 		, m_size(*this, rhs.m_size)
 	{
 
@@ -190,6 +212,8 @@ public:
 		: m_begin(std::move(rhs.m_begin))
 		, m_end(std::move(rhs.m_end))
 		, m_r(std::move(rhs.m_r))
+		, m_source_size(*this, std::move(rhs.m_source_size))
+		, m_fingerprint(*this, std::move(rhs.m_fingerprint))
 		, m_size(*this, std::move(rhs.m_size))
 	{}
 
@@ -199,12 +223,18 @@ public:
 	 *	the possibly laborious std::equal, but MSVC gives a run-time assert whenever comparing
 	 *	iterators from different containers.  I'm trying not to get too upset about it, because
 	 *	I can understand the sentiment.  None-the-less it has proven rather irritating.
+	 *	Comparing the addresses of the first elements says the same thing without upsetting MSVC.
+	 *
+	 *		The source length and fingerprint are cached on first use, so after that two
+	 *	combinations over different sources are usually told apart in constant time.
+	 *	Only equal fingerprints over distinct sources need the element-wise std::equal.
 	 */
 	bool operator==(const combinations& rhs) const
 	{
 		return (m_r == rhs.m_r)
-			&& (size() == rhs.size())
-			&& std::equal(m_begin, m_end, rhs.m_begin);
+			&& (source_size() == rhs.source_size())
+			&& (same_source(rhs)
+				|| ((m_fingerprint == rhs.m_fingerprint) && std::equal(m_begin, m_end, rhs.m_begin)));
 	}
 
 	const_iterator begin() const
@@ -234,31 +264,62 @@ public:
 	   * container may not be a constant-time operation.  If the source iterators are only
 	   * forward iterators, not random-access, then finding the size of the base container will
 	   * cost on the order of the size of the base container.  Once calculated, the size will be
-	   * cached for successive calls.
+	   * cached for successive calls.  The cache is lock-free, so one combinations object may be
+	   * shared read-only between threads that all call size().
 	   *
-	   * \see evaluate_size()
+	   * \throws std::overflow_error if the number of combinations does not fit a size_type.
+	   * \see evaluate_size(), exact_size()
 	   */
 	size_type size() const
 	{
 		return m_size;
 	}
 
+	/// The number of combinations, however large.
+	big_count exact_size() const
+	{
+		return exact_binomial(source_size(), m_r);
+	}
+
 private:
 
+	size_type source_size() const
+	{
+		return m_source_size;
+	}
+
+	/// True if both objects start at the same element, and so (being equally long) span the same elements.
+	bool same_source(combinations const& rhs) const
+	{
+		return (m_begin == m_end)
+			|| power_iterator_detail::same_element(m_begin, rhs.m_begin);
+	}
+
+	size_type evaluate_source_size() const
+	{
+		return std::distance(m_begin, m_end);
+	}
+
+	std::size_t evaluate_fingerprint() const
+	{
+		return power_iterator_detail::fingerprint(m_begin, m_end);
+	}
+
 	size_type evaluate_size() const
 	{
-		auto n = std::distance(m_begin, m_end);
-		size_type r_max = std::min(m_r, n - m_r);
-		size_type size{ 1 };
-		for (size_type r = 0; r++ < r_max; n--)
-			(size *= n) /= r;
-		return size;
+		std::uint64_t size;
+		if (!checked_binomial(source_size(), m_r, size)
+			|| (size > std::numeric_limits<size_type>::max()))
+			throw std::overflow_error("combinations::size: too many combinations for size_type");
+		return static_cast<size_type>(size);
 	}
 
 	source_iterator m_begin;
 	source_iterator m_end;
 	size_type m_r;	// 'r' as in nCr.
-	MemoizedMember<size_type, combinations, &combinations::evaluate_size> m_size{ *this };
+	AtomicMemoizedMember<size_type, combinations, &combinations::evaluate_source_size> m_source_size{ *this };
+	AtomicMemoizedMember<std::size_t, combinations, &combinations::evaluate_fingerprint> m_fingerprint{ *this };
+	AtomicMemoizedMember<size_type, combinations, &combinations::evaluate_size> m_size{ *this };
 
 };
 
@@ -0,0 +1,259 @@
+/**
+*	\author    John Szwast
+*	\year      2014-2016
+*	\copyright MIT
+*/
+
+
+#pragma once
+
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+/**
+ *	An unsigned integer of unlimited size, for counts that overflow the fixed-width types.
+ *	It supports only what counting needs: multiplication and exact division by small factors,
+ *	comparison, and conversion.
+ */
+class big_count
+{
+public:
+	big_count(std::uint64_t value = 0)
+	{
+		for (; value != 0; value >>= 32)
+			m_limbs.push_back(static_cast<std::uint32_t>(value));
+	}
+
+	/// 2^exponent
+	static big_count power_of_two(std::size_t exponent)
+	{
+		big_count result;
+		result.m_limbs.assign(exponent / 32 + 1, 0);
+		result.m_limbs.back() = std::uint32_t{ 1 } << (exponent % 32);
+		return result;
+	}
+
+	big_count& operator*=(std::uint64_t factor)
+	{
+		std::uint32_t const halves[2] = { static_cast<std::uint32_t>(factor), static_cast<std::uint32_t>(factor >> 32) };
+		std::vector<std::uint32_t> product(m_limbs.size() + 2, 0);
+		for (std::size_t j = 0; j < 2; ++j)
+		{
+			// limb * half + product + carry never exceeds 2^64 - 1.
+			std::uint64_t carry = 0;
+			for (std::size_t i = 0; i < m_limbs.size(); ++i)
+			{
+				carry += std::uint64_t{ m_limbs[i] } * halves[j] + product[i + j];
+				product[i + j] = static_cast<std::uint32_t>(carry);
+				carry >>= 32;
+			}
+			product[m_limbs.size() + j] = static_cast<std::uint32_t>(carry);
+		}
+		m_limbs.swap(product);
+		trim();
+		return *this;
+	}
+
+	/// Divides in place and returns the remainder.
+	std::uint32_t divide(std::uint32_t divisor)
+	{
+		std::uint64_t remainder = 0;
+		for (auto limb = m_limbs.rbegin(); limb != m_limbs.rend(); ++limb)
+		{
+			remainder = (remainder << 32) | *limb;
+			*limb = static_cast<std::uint32_t>(remainder / divisor);
+			remainder %= divisor;
+		}
+		trim();
+		return static_cast<std::uint32_t>(remainder);
+	}
+
+	/// True if the value is representable as an Unsigned.
+	template<typename Unsigned>
+	bool fits() const
+	{
+		return bit_width() <= static_cast<std::size_t>(std::numeric_limits<Unsigned>::digits);
+	}
+
+	/// The value, which must fit an Unsigned.
+	template<typename Unsigned>
+	Unsigned to() const
+	{
+		Unsigned value{ 0 };
+		for (auto limb = m_limbs.rbegin(); limb != m_limbs.rend(); ++limb)
+			value = static_cast<Unsigned>((value << 16) << 16) | *limb;
+		return value;
+	}
+
+	std::size_t bit_width() const
+	{
+		if (m_limbs.empty())
+			return 0;
+		std::size_t width = 32 * (m_limbs.size() - 1);
+		for (std::uint32_t top = m_limbs.back(); top != 0; top >>= 1)
+			++width;
+		return width;
+	}
+
+	std::string to_string() const
+	{
+		if (m_limbs.empty())
+			return "0";
+		big_count quotient{ *this };
+		std::string digits;
+		while (!quotient.m_limbs.empty())
+			digits.push_back(static_cast<char>('0' + quotient.divide(10)));
+		std::reverse(digits.begin(), digits.end());
+		return digits;
+	}
+
+	bool operator==(big_count const& rhs) const
+	{
+		return m_limbs == rhs.m_limbs;
+	}
+
+	bool operator<(big_count const& rhs) const
+	{
+		if (m_limbs.size() != rhs.m_limbs.size())
+			return m_limbs.size() < rhs.m_limbs.size();
+		return std::lexicographical_compare(m_limbs.rbegin(), m_limbs.rend(),
+			rhs.m_limbs.rbegin(), rhs.m_limbs.rend());
+	}
+
+private:
+
+	void trim()
+	{
+		while (!m_limbs.empty() && (m_limbs.back() == 0))
+			m_limbs.pop_back();
+	}
+
+	std::vector<std::uint32_t> m_limbs;	// Least significant first, no leading zeros.
+};
+
+
+namespace power_iterator_detail
+{
+
+	/// The largest n for which every nCk fits 64 bits: C(67, 33) does, C(68, 34) does not.
+	constexpr std::size_t pascal_rows = 68;
+
+
+	/// Rows [0, pascal_rows) of Pascal's triangle, stored row after row.
+	struct pascal_triangle
+	{
+		constexpr pascal_triangle()
+			: values{}
+		{
+			for (std::size_t n = 0; n < pascal_rows; ++n)
+			{
+				values[offset(n)] = 1;
+				values[offset(n) + n] = 1;
+				for (std::size_t k = 1; k < n; ++k)
+					values[offset(n) + k] = values[offset(n - 1) + k - 1] + values[offset(n - 1) + k];
+			}
+		}
+
+		static constexpr std::size_t offset(std::size_t n)
+		{
+			return n * (n + 1) / 2;
+		}
+
+		constexpr std::uint64_t operator()(std::size_t n, std::size_t k) const
+		{
+			return values[offset(n) + k];
+		}
+
+		std::uint64_t values[pascal_rows * (pascal_rows + 1) / 2];
+	};
+
+
+	template<typename = void>
+	struct pascal
+	{
+		static constexpr pascal_triangle table{};
+	};
+
+	template<typename T>
+	constexpr pascal_triangle pascal<T>::table;
+
+}
+
+
+/**
+ *	Computes nCk into result.
+ *	Returns false, leaving result unspecified, if nCk does not fit a std::uint64_t.
+ *
+ *	A table lookup for n < 68.  Beyond the table only k < 34 (or n - k < 34) can fit, and those
+ *	take at most 33 exact multiply-divide steps, each checked for overflow.
+ */
+inline bool checked_binomial(std::uint64_t n, std::uint64_t k, std::uint64_t& result)
+{
+	if (k > n)
+	{
+		result = 0;
+		return true;
+	}
+	k = std::min(k, n - k);
+	if (n < power_iterator_detail::pascal_rows)
+	{
+		result = power_iterator_detail::pascal<>::table(static_cast<std::size_t>(n), static_cast<std::size_t>(k));
+		return true;
+	}
+	if (k >= power_iterator_detail::pascal_rows / 2)
+		return false;	// nCk >= C(68, 34)
+
+	std::uint64_t c{ 1 };
+	for (std::uint64_t i = 1; i <= k; ++i)
+	{
+		// c * (n - k + i) / i is exact.  Cancel the common factor of c and i first, so that
+		// the product only overflows when the binomial itself does.
+		std::uint64_t g = c, d = i;
+		while (d != 0)
+		{
+			std::uint64_t t = g % d;
+			g = d;
+			d = t;
+		}
+		std::uint64_t const factor = (n - k + i) / (i / g);
+		c /= g;
+		if (c > std::numeric_limits<std::uint64_t>::max() / factor)
+			return false;
+		c *= factor;
+	}
+	result = c;
+	return true;
+}
+
+
+/**
+ *	nCk to any size.
+ *
+ *	\throws std::length_error if min(k, n - k) >= 2^32; such a count would have billions of digits.
+ */
+inline big_count exact_binomial(std::uint64_t n, std::uint64_t k)
+{
+	std::uint64_t small;
+	if (checked_binomial(n, k, small))
+		return big_count{ small };
+
+	k = std::min(k, n - k);
+	if (k > std::numeric_limits<std::uint32_t>::max())
+		throw std::length_error("exact_binomial: k too large");
+
+	big_count c{ 1 };
+	for (std::uint64_t i = 1; i <= k; ++i)
+	{
+		// C(n - k + i, i) = C(n - k + i - 1, i - 1) * (n - k + i) / i, exactly.
+		c *= n - k + i;
+		c.divide(static_cast<std::uint32_t>(i));
+	}
+	return c;
+}
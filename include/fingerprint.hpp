@@ -0,0 +1,117 @@
+/**
+*	\author    John Szwast
+*	\year      2014-2016
+*	\copyright MIT
+*/
+
+
+#pragma once
+
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+
+namespace power_iterator_detail
+{
+
+	/// Detects whether std::hash<T> is enabled for T.
+	template<typename T, typename = void>
+	struct is_hashable : std::false_type {};
+
+	template<typename T>
+	struct is_hashable<T, decltype(void(std::hash<T>{}(std::declval<T const&>())))> : std::true_type {};
+
+
+	inline std::size_t hash_combine(std::size_t seed, std::size_t value)
+	{
+		return seed ^ (value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2));
+	}
+
+
+	template<typename Iter>
+	std::size_t fingerprint(Iter begin, Iter end, std::true_type /*hashable*/)
+	{
+		using value_type = typename std::iterator_traits<Iter>::value_type;
+		std::hash<value_type> hasher;
+		std::size_t seed{ 0 };
+		for (; begin != end; ++begin)
+			seed = hash_combine(seed, hasher(*begin));
+		return seed;
+	}
+
+
+	template<typename Iter>
+	std::size_t fingerprint(Iter, Iter, std::false_type /*hashable*/)
+	{
+		return 0;
+	}
+
+
+	/**
+	 *	Opts a view type, returned by value from its source's iterators, into identity by position:
+	 *	two views with the same data() are the same element of the same source, as for
+	 *	record_view.  Specialise it only for views whose sources never share storage.
+	 */
+	template<typename T>
+	struct identified_by_data : std::false_type {};
+
+
+	template<typename Iter>
+	bool same_view(Iter const& lhs, Iter const& rhs, std::true_type /*identified by data()*/)
+	{
+		return (*lhs).data() == (*rhs).data();
+	}
+
+	template<typename Iter>
+	bool same_view(Iter const&, Iter const&, std::false_type /*identified by data()*/)
+	{
+		return false;
+	}
+
+
+	template<typename Iter>
+	bool same_element(Iter const& lhs, Iter const& rhs, std::true_type /*lvalue reference*/)
+	{
+		return std::addressof(*lhs) == std::addressof(*rhs);
+	}
+
+	template<typename Iter>
+	bool same_element(Iter const& lhs, Iter const& rhs, std::false_type /*lvalue reference*/)
+	{
+		using reference = typename std::iterator_traits<Iter>::reference;
+		return same_view(lhs, rhs, identified_by_data<typename std::decay<reference>::type>{});
+	}
+
+	/**
+	 *	True if lhs and rhs are known to refer to the very same element.
+	 *	Unlike lhs == rhs, this is allowed for iterators into different containers.
+	 *	Iterators that dereference to temporaries are only known to when the temporaries are
+	 *	views opted in through identified_by_data, like record_view, with the same data().
+	 */
+	template<typename Iter>
+	bool same_element(Iter const& lhs, Iter const& rhs)
+	{
+		using reference = typename std::iterator_traits<Iter>::reference;
+		return same_element(lhs, rhs, std::is_lvalue_reference<reference>{});
+	}
+
+
+	/**
+	 *	A content fingerprint of the range [begin, end).  Equal ranges have equal fingerprints,
+	 *	so differing fingerprints prove inequality without visiting the elements again.
+	 *	If the element type has no std::hash, every range fingerprints to 0 and
+	 *	the comparison falls back to the elements themselves.
+	 */
+	template<typename Iter>
+	std::size_t fingerprint(Iter begin, Iter end)
+	{
+		using value_type = typename std::iterator_traits<Iter>::value_type;
+		return fingerprint(begin, end, is_hashable<value_type>{});
+	}
+
+}
@@ -0,0 +1,469 @@
+/**
+*	\author    John Szwast
+*	\year      2014-2016
+*	\copyright MIT
+*/
+
+
+#pragma once
+
+
+#include <cerrno>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+#if defined(_WIN32)
+#	ifndef NOMINMAX
+#		define NOMINMAX
+#	endif
+#	include <windows.h>
+#else
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+#include "combination_iterator.hpp"
+#include "power_iterator.hpp"
+
+
+/**
+ *	A view of one fixed-width record inside a mapped_records file.
+ *
+ *	Views are ordered and compared by position in the file, not by content, so subsets of
+ *	records keep file order and two equal records at different positions stay distinct.
+ */
+class record_view
+{
+public:
+	record_view() = default;
+
+	record_view(char const* data, std::size_t size)
+		: m_data(data)
+		, m_size(size)
+	{
+
+	}
+
+	char const* data() const
+	{
+		return m_data;
+	}
+
+	std::size_t size() const
+	{
+		return m_size;
+	}
+
+	/// The record as a T.  The record must hold a suitably aligned T.
+	template<typename T>
+	T const& as() const
+	{
+		return *reinterpret_cast<T const*>(m_data);
+	}
+
+	bool operator==(record_view const& rhs) const
+	{
+		return m_data == rhs.m_data;
+	}
+
+	bool operator<(record_view const& rhs) const
+	{
+		return std::less<char const*>{}(m_data, rhs.m_data);
+	}
+
+private:
+	char const* m_data = nullptr;
+	std::size_t m_size = 0;
+};
+
+
+namespace power_iterator_detail
+{
+	/// Each record has its own place in a mapping, and mappings do not overlap.
+	template<>
+	struct identified_by_data<record_view> : std::true_type {};
+}
+
+
+namespace std
+{
+	/// Hashes a record_view by position, consistently with its operator==.
+	template<>
+	struct hash<record_view>
+	{
+		std::size_t operator()(record_view const& record) const
+		{
+			return std::hash<char const*>{}(record.data());
+		}
+	};
+}
+
+
+/**
+ *	A read-only memory mapping of a file of fixed-width records, as a random-access container
+ *	of record_view.
+ *
+ *	It can be the Source of combinations and powerset (see mapped_combinations and
+ *	mapped_powerset), which then enumerate subsets of records in place: nothing is loaded
+ *	or copied up front, and subsets hold views into the mapping.
+ *	The mapping must outlive every combinations, powerset and record_view made from it.
+ */
+class mapped_records
+{
+public:
+	using value_type = record_view;
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+
+	/// Access pattern hints for the kernel's paging.
+	enum class access
+	{
+		normal,
+		sequential,
+		random,
+		will_need
+	};
+
+	class const_iterator
+	{
+	public:
+		using difference_type = mapped_records::difference_type;
+		using value_type = record_view;
+		using pointer = void;
+		using reference = record_view;
+		using iterator_category = std::random_access_iterator_tag;
+
+		const_iterator() = default;
+
+		const_iterator(char const* position, size_type record_size)
+			: m_position(position)
+			, m_record_size(record_size)
+		{
+
+		}
+
+		reference operator*() const
+		{
+			return record_view(m_position, m_record_size);
+		}
+
+		reference operator[](difference_type n) const
+		{
+			return *(*this + n);
+		}
+
+		const_iterator& operator++()
+		{
+			m_position += m_record_size;
+			return *this;
+		}
+
+		const_iterator operator++(int)
+		{
+			const_iterator temp{ *this };
+			++*this;
+			return temp;
+		}
+
+		const_iterator& operator--()
+		{
+			m_position -= m_record_size;
+			return *this;
+		}
+
+		const_iterator operator--(int)
+		{
+			const_iterator temp{ *this };
+			--*this;
+			return temp;
+		}
+
+		const_iterator& operator+=(difference_type n)
+		{
+			m_position += n * static_cast<difference_type>(m_record_size);
+			return *this;
+		}
+
+		const_iterator& operator-=(difference_type n)
+		{
+			return *this += -n;
+		}
+
+		friend const_iterator operator+(const_iterator it, difference_type n)
+		{
+			return it += n;
+		}
+
+		friend const_iterator operator+(difference_type n, const_iterator it)
+		{
+			return it += n;
+		}
+
+		friend const_iterator operator-(const_iterator it, difference_type n)
+		{
+			return it -= n;
+		}
+
+		friend difference_type operator-(const_iterator const& lhs, const_iterator const& rhs)
+		{
+			return (lhs.m_position - rhs.m_position) / static_cast<difference_type>(lhs.m_record_size);
+		}
+
+		bool operator==(const_iterator const& rhs) const
+		{
+			return m_position == rhs.m_position;
+		}
+
+		bool operator!=(const_iterator const& rhs) const
+		{
+			return m_position != rhs.m_position;
+		}
+
+		bool operator<(const_iterator const& rhs) const
+		{
+			return m_position < rhs.m_position;
+		}
+
+		bool operator>(const_iterator const& rhs) const
+		{
+			return rhs < *this;
+		}
+
+		bool operator<=(const_iterator const& rhs) const
+		{
+			return !(rhs < *this);
+		}
+
+		bool operator>=(const_iterator const& rhs) const
+		{
+			return !(*this < rhs);
+		}
+
+	private:
+		char const* m_position = nullptr;
+		size_type m_record_size = 0;
+	};
+
+	using iterator = const_iterator;
+
+	/**
+	 *	Maps the file at path and advises the kernel that it will be read sequentially,
+	 *	which is how combinations and powerset walk it.
+	 *
+	 *	\throws std::invalid_argument if record_size is 0 or the file is not a whole number of records.
+	 *	\throws std::system_error if the file cannot be opened or mapped.
+	 */
+	mapped_records(std::string const& path, size_type record_size)
+		: m_record_size(record_size)
+	{
+		if (m_record_size == 0)
+			throw std::invalid_argument("mapped_records: record size must be positive");
+		map(path);
+		if (m_bytes % m_record_size != 0)
+		{
+			unmap();
+			throw std::invalid_argument("mapped_records: file size is not a multiple of the record size");
+		}
+		advise(access::sequential);
+	}
+
+	mapped_records(mapped_records const&) = delete;
+	mapped_records& operator=(mapped_records const&) = delete;
+
+	mapped_records(mapped_records&& rhs)
+		: m_data(rhs.m_data)
+		, m_bytes(rhs.m_bytes)
+		, m_record_size(rhs.m_record_size)
+	{
+		rhs.m_data = nullptr;
+		rhs.m_bytes = 0;
+	}
+
+	mapped_records& operator=(mapped_records&& rhs)
+	{
+		if (this != &rhs)
+		{
+			unmap();
+			m_data = rhs.m_data;
+			m_bytes = rhs.m_bytes;
+			m_record_size = rhs.m_record_size;
+			rhs.m_data = nullptr;
+			rhs.m_bytes = 0;
+		}
+		return *this;
+	}
+
+	~mapped_records()
+	{
+		unmap();
+	}
+
+	const_iterator begin() const
+	{
+		return const_iterator(m_data, m_record_size);
+	}
+
+	const_iterator cbegin() const
+	{
+		return begin();
+	}
+
+	const_iterator end() const
+	{
+		return const_iterator(m_data + m_bytes, m_record_size);
+	}
+
+	const_iterator cend() const
+	{
+		return end();
+	}
+
+	record_view operator[](size_type i) const
+	{
+		return record_view(m_data + i * m_record_size, m_record_size);
+	}
+
+	size_type size() const
+	{
+		return m_bytes / m_record_size;
+	}
+
+	bool empty() const
+	{
+		return m_bytes == 0;
+	}
+
+	size_type record_size() const
+	{
+		return m_record_size;
+	}
+
+	char const* data() const
+	{
+		return m_data;
+	}
+
+	/// Passes an access pattern hint for the whole mapping to the kernel.  Hints are best effort.
+	void advise(access pattern) const
+	{
+#if defined(_WIN32)
+		(void)pattern;
+#else
+		if (m_bytes == 0)
+			return;
+		int advice = MADV_NORMAL;
+		switch (pattern)
+		{
+		case access::normal: advice = MADV_NORMAL; break;
+		case access::sequential: advice = MADV_SEQUENTIAL; break;
+		case access::random: advice = MADV_RANDOM; break;
+		case access::will_need: advice = MADV_WILLNEED; break;
+		}
+		::madvise(const_cast<char*>(m_data), m_bytes, advice);
+#endif
+	}
+
+private:
+
+#if defined(_WIN32)
+	void map(std::string const& path)
+	{
+		HANDLE file = ::CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+			OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+			throw std::system_error(static_cast<int>(::GetLastError()), std::system_category(), "mapped_records: " + path);
+
+		LARGE_INTEGER size;
+		if (!::GetFileSizeEx(file, &size))
+		{
+			auto error = ::GetLastError();
+			::CloseHandle(file);
+			throw std::system_error(static_cast<int>(error), std::system_category(), "mapped_records: " + path);
+		}
+		m_bytes = static_cast<size_type>(size.QuadPart);
+		if (m_bytes == 0)
+		{
+			::CloseHandle(file);
+			return;
+		}
+
+		HANDLE mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		auto error = ::GetLastError();
+		::CloseHandle(file);
+		if (mapping == nullptr)
+			throw std::system_error(static_cast<int>(error), std::system_category(), "mapped_records: " + path);
+
+		m_data = static_cast<char const*>(::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+		error = ::GetLastError();
+		::CloseHandle(mapping);	// The view keeps the mapping alive.
+		if (m_data == nullptr)
+			throw std::system_error(static_cast<int>(error), std::system_category(), "mapped_records: " + path);
+	}
+
+	void unmap()
+	{
+		if (m_data != nullptr)
+			::UnmapViewOfFile(m_data);
+		m_data = nullptr;
+		m_bytes = 0;
+	}
+#else
+	void map(std::string const& path)
+	{
+		int fd = ::open(path.c_str(), O_RDONLY);
+		if (fd < 0)
+			throw std::system_error(errno, std::generic_category(), "mapped_records: " + path);
+
+		struct stat status;
+		if (::fstat(fd, &status) != 0)
+		{
+			int error = errno;
+			::close(fd);
+			throw std::system_error(error, std::generic_category(), "mapped_records: " + path);
+		}
+		m_bytes = static_cast<size_type>(status.st_size);
+		if (m_bytes == 0)
+		{
+			::close(fd);
+			return;
+		}
+
+		void* address = ::mmap(nullptr, m_bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+		int error = errno;
+		::close(fd);	// The mapping keeps the file alive.
+		if (address == MAP_FAILED)
+		{
+			m_bytes = 0;
+			throw std::system_error(error, std::generic_category(), "mapped_records: " + path);
+		}
+		m_data = static_cast<char const*>(address);
+	}
+
+	void unmap()
+	{
+		if (m_data != nullptr)
+			::munmap(const_cast<char*>(m_data), m_bytes);
+		m_data = nullptr;
+		m_bytes = 0;
+	}
+#endif
+
+	char const* m_data = nullptr;
+	size_type m_bytes = 0;
+	size_type m_record_size;
+};
+
+
+/// Combinations of the records of a mapped file, as sets of record_view.
+using mapped_combinations = combinations<record_view, std::less<record_view>, std::allocator<record_view>, mapped_records>;
+
+/// The power set of the records of a mapped file, as sets of record_view.
+using mapped_powerset = powerset<record_view, std::less<record_view>, std::allocator<record_view>, mapped_records>;
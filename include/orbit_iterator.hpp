@@ -0,0 +1,431 @@
+/**
+*	\author    John Szwast
+*	\year      2014-2016
+*	\copyright MIT
+*/
+
+
+#pragma once
+
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "counting.hpp"
+
+
+/**
+ *	A group of permutations of the positions [0, n) of a source, under which subsets that map
+ *	onto each other are considered equivalent.
+ *
+ *	A subset, as its ascending list of positions, is canonical when no permutation in the group
+ *	maps it to a lexicographically smaller list.  Removing the largest position from a
+ *	canonical subset leaves a canonical subset, which is what lets orbit_combinations prune
+ *	its search at the first non-canonical prefix.
+ *
+ *	Groups given by generators are expanded to all of their elements, so each canonical test
+ *	costs O(|G| r log r); that suits small groups such as mirror images or rotations.
+ *	Classes of interchangeable elements generate the product of their symmetric groups, which
+ *	is usually far too large to list, so they are handled directly: a subset is canonical when
+ *	the previous member of each chosen position's class is chosen too, which is a binary search
+ *	of the positions.  That is O(r log r) for a whole subset, and O(log r) per step of
+ *	orbit_combinations' search, which only checks the position it just added.
+ */
+class symmetry_group
+{
+public:
+	using size_type = std::size_t;
+	using permutation = std::vector<size_type>;
+
+	/**
+	 *	The group that permutes the members of each class freely.  Positions in no class are
+	 *	fixed.
+	 *
+	 *	\throws std::invalid_argument if a position is out of range or in more than one class.
+	 */
+	static symmetry_group interchangeable(size_type n, std::vector<std::vector<size_type>> classes)
+	{
+		symmetry_group group(n);
+		group.m_interchangeable = true;
+		group.m_class_of.resize(n);
+		group.m_previous_in_class.resize(n);
+		group.m_class_sizes.assign(n, 1);
+		for (size_type i = 0; i < n; ++i)
+			group.m_class_of[i] = group.m_previous_in_class[i] = i;
+
+		std::vector<bool> seen(n, false);
+		for (auto& members : classes)
+		{
+			if (members.empty())
+				continue;
+			std::sort(members.begin(), members.end());
+			for (size_type rank = 0; rank < members.size(); ++rank)
+			{
+				size_type const i = members[rank];
+				if ((i >= n) || seen[i])
+					throw std::invalid_argument("symmetry_group: classes must be disjoint positions of the source");
+				seen[i] = true;
+				group.m_class_of[i] = members.front();
+				group.m_previous_in_class[i] = (rank == 0) ? i : members[rank - 1];
+			}
+			group.m_class_sizes[members.front()] = members.size();
+		}
+		return group;
+	}
+
+	/**
+	 *	The group generated by the given permutations, each a rearrangement of [0, n) mapping
+	 *	position i to generator[i].
+	 *
+	 *	\throws std::invalid_argument if a generator is not a permutation of [0, n).
+	 *	\throws std::length_error if the group has more than max_order elements.
+	 */
+	static symmetry_group generated_by(size_type n, std::vector<permutation> const& generators,
+		size_type max_order = 1u << 20)
+	{
+		for (auto const& generator : generators)
+		{
+			permutation sorted(generator);
+			std::sort(sorted.begin(), sorted.end());
+			for (size_type i = 0; i < sorted.size(); ++i)
+				if (sorted[i] != i)
+					throw std::invalid_argument("symmetry_group: generators must be permutations of the source positions");
+			if (sorted.size() != n)
+				throw std::invalid_argument("symmetry_group: generators must be permutations of the source positions");
+		}
+
+		// Close the identity under composition with the generators, breadth first.
+		permutation identity(n);
+		for (size_type i = 0; i < n; ++i)
+			identity[i] = i;
+		std::set<permutation> elements{ identity };
+		std::vector<permutation> frontier{ identity };
+		while (!frontier.empty())
+		{
+			std::vector<permutation> next;
+			for (auto const& element : frontier)
+				for (auto const& generator : generators)
+				{
+					permutation composed(n);
+					for (size_type i = 0; i < n; ++i)
+						composed[i] = generator[element[i]];
+					if (elements.insert(composed).second)
+					{
+						if (elements.size() > max_order)
+							throw std::length_error("symmetry_group: too many group elements to list");
+						next.push_back(std::move(composed));
+					}
+				}
+			frontier.swap(next);
+		}
+
+		symmetry_group group(n);
+		group.m_elements.assign(elements.begin(), elements.end());
+		return group;
+	}
+
+	/// The number of positions permuted.
+	size_type degree() const
+	{
+		return m_n;
+	}
+
+	/// True if the ascending positions are the lexicographically least of their orbit.
+	bool is_canonical(std::vector<size_type> const& positions) const
+	{
+		if (m_interchangeable)
+		{
+			// Canonical when every class contributes its lowest positions.
+			for (auto j = positions.begin(); j != positions.end(); ++j)
+				if (!previous_chosen(positions.begin(), j))
+					return false;
+			return true;
+		}
+
+		std::vector<size_type> image(positions.size());
+		for (auto const& element : m_elements)
+		{
+			map(element, positions, image);
+			if (image < positions)
+				return false;
+		}
+		return true;
+	}
+
+	/**
+	 *	True if the ascending positions are canonical, given that they are without their last
+	 *	position.  For classes this only checks the last position; generated groups check all.
+	 */
+	bool extends_canonical(std::vector<size_type> const& positions) const
+	{
+		if (m_interchangeable)
+			return positions.empty() || previous_chosen(positions.begin(), positions.end() - 1);
+		return is_canonical(positions);
+	}
+
+	/**
+	 *	The number of subsets equivalent to the given one, itself included.
+	 *
+	 *	\throws std::overflow_error if that does not fit a std::uint64_t.
+	 */
+	std::uint64_t orbit_size(std::vector<size_type> const& positions) const
+	{
+		if (m_interchangeable)
+		{
+			// The product over classes of C(class size, members chosen), in O(r log r).
+			std::vector<size_type> classes;
+			classes.reserve(positions.size());
+			for (auto i : positions)
+				classes.push_back(m_class_of[i]);
+			std::sort(classes.begin(), classes.end());
+
+			std::uint64_t size{ 1 };
+			for (auto first = classes.begin(); first != classes.end(); )
+			{
+				auto const last = std::upper_bound(first, classes.end(), *first);
+				std::uint64_t ways;
+				if (!checked_binomial(m_class_sizes[*first], static_cast<std::uint64_t>(last - first), ways)
+					|| ((ways != 0) && (size > std::numeric_limits<std::uint64_t>::max() / ways)))
+					throw std::overflow_error("symmetry_group::orbit_size: orbit too large");
+				size *= ways;
+				first = last;
+			}
+			return size;
+		}
+
+		// |G| / |stabilizer|
+		std::vector<size_type> image(positions.size());
+		std::uint64_t stabilizer{ 0 };
+		for (auto const& element : m_elements)
+		{
+			map(element, positions, image);
+			if (image == positions)
+				++stabilizer;
+		}
+		return m_elements.size() / stabilizer;
+	}
+
+private:
+
+	explicit symmetry_group(size_type n)
+		: m_n(n)
+	{
+
+	}
+
+	static void map(permutation const& element, std::vector<size_type> const& positions, std::vector<size_type>& image)
+	{
+		for (size_type j = 0; j < positions.size(); ++j)
+			image[j] = element[positions[j]];
+		std::sort(image.begin(), image.end());
+	}
+
+	/// True if *j is the lowest member of its class or its previous member is in [begin, j).
+	bool previous_chosen(std::vector<size_type>::const_iterator begin, std::vector<size_type>::const_iterator j) const
+	{
+		size_type const previous = m_previous_in_class[*j];
+		return (previous == *j) || std::binary_search(begin, j, previous);
+	}
+
+	size_type m_n;
+	bool m_interchangeable = false;
+
+	// Generated groups: every element.
+	std::vector<permutation> m_elements;
+
+	// Interchangeable classes, identified by their lowest position.
+	std::vector<size_type> m_class_of;
+	std::vector<size_type> m_previous_in_class;	// Itself for the lowest member of a class.
+	std::vector<size_type> m_class_sizes;	// Indexed by class.
+};
+
+
+/**
+ *	A virtual container of one representative combination per orbit of a symmetry_group.
+ *
+ *	Where combinations would produce every r-subset, orbit_combinations produces only the
+ *	canonical (lexicographically least) subset of each set of equivalent ones, by orderly
+ *	generation: a depth-first search over ascending positions that abandons a branch as soon
+ *	as its prefix is not canonical.  The iterator's multiplicity() is the number of subsets
+ *	the current representative stands for, so the multiplicities sum to nCr.
+ *	Representatives come in lexicographic order, like combinations.
+ */
+template<typename Key,
+	class Compare = std::less<Key>,
+	class Allocator = std::allocator<Key>,
+	class Source = std::set<Key, Compare, Allocator>>
+	class orbit_combinations
+{
+public:
+	using key_type = std::set<Key, Compare, Allocator>;
+	using value_type = key_type;
+	using size_type = typename value_type::size_type;
+	using source_type = Source;
+	using source_iterator = typename source_type::const_iterator;
+
+	class const_iterator
+	{
+	public:
+		/// Type_traits aliases
+		using difference_type = std::ptrdiff_t;
+		using value_type = key_type const;
+		using pointer = value_type const*;
+		using reference = value_type const&;
+		using iterator_category = std::forward_iterator_tag;
+
+		bool operator==(const_iterator const& rhs) const
+		{
+			return (m_at_end == rhs.m_at_end)
+				&& (m_at_end || (m_rank == rhs.m_rank));
+		}
+
+		bool operator!=(const_iterator const& rhs) const
+		{
+			return !(*this == rhs);
+		}
+
+		const_iterator& operator++()
+		{
+			increment();
+			return *this;
+		}
+
+		const_iterator operator++(int)
+		{
+			const_iterator temp{ *this };
+			increment();
+			return temp;
+		}
+
+		reference operator*() const
+		{
+			m_value.clear();
+			for (auto i : m_positions)
+				m_value.insert(m_value.end(), *m_owner->m_elements[i]);
+			return m_value;
+		}
+
+		/// The source positions of the current representative, ascending.
+		std::vector<size_type> const& positions() const
+		{
+			return m_positions;
+		}
+
+		/// The number of combinations equivalent to the current representative, itself included.
+		std::uint64_t multiplicity() const
+		{
+			return m_owner->m_group.orbit_size(m_positions);
+		}
+
+	private:
+		friend class orbit_combinations;
+
+		const_iterator(orbit_combinations const& owner, bool end)
+			: m_owner(&owner)
+			, m_rank(0)
+			, m_at_end(end || (owner.m_r > owner.m_elements.size()))
+		{
+			if (!m_at_end)
+				m_at_end = !settle();
+		}
+
+		void increment()
+		{
+			if (!m_at_end)
+			{
+				++m_rank;
+				m_at_end = !(bump() && settle());
+			}
+		}
+
+		/// Moves the last position forward, backtracking when there is no room left; false when exhausted.
+		bool bump()
+		{
+			size_type const n = m_owner->m_elements.size();
+			while (!m_positions.empty())
+			{
+				// Leave room for the positions still to be chosen after this one.
+				if (++m_positions.back() + (m_owner->m_r - m_positions.size()) < n)
+					return true;
+				m_positions.pop_back();
+			}
+			return false;
+		}
+
+		/// Extends the canonical prefix to a canonical r-subset; false when exhausted.
+		bool settle()
+		{
+			for (;;)
+			{
+				// The prefix without its last position was accepted before.
+				if (!m_positions.empty() && !m_owner->m_group.extends_canonical(m_positions))
+				{
+					if (!bump())
+						return false;
+					continue;
+				}
+				if (m_positions.size() == m_owner->m_r)
+					return true;
+				m_positions.push_back(m_positions.empty() ? 0 : m_positions.back() + 1);
+			}
+		}
+
+		orbit_combinations const* m_owner;
+		std::vector<size_type> m_positions;	// The current prefix, ascending.
+		mutable key_type m_value;	// The value returned by dereferencing.
+		size_type m_rank;
+		bool m_at_end;
+	};
+
+	using iterator = const_iterator;
+
+	orbit_combinations(source_type const& source, size_type r, symmetry_group group)
+		: orbit_combinations(source.begin(), source.end(), r, std::move(group))
+	{
+
+	}
+
+	/// \throws std::invalid_argument if the group does not permute exactly the source's positions.
+	orbit_combinations(source_iterator source_begin, source_iterator source_end, size_type r, symmetry_group group)
+		: m_r(r)
+		, m_group(std::move(group))
+	{
+		for (; source_begin != source_end; ++source_begin)
+			m_elements.push_back(source_begin);
+		if (m_group.degree() != m_elements.size())
+			throw std::invalid_argument("orbit_combinations: the group's degree must match the source size");
+	}
+
+	const_iterator begin() const
+	{
+		return const_iterator(*this, false);
+	}
+
+	const_iterator cbegin() const
+	{
+		return begin();
+	}
+
+	const_iterator end() const
+	{
+		return const_iterator(*this, true);
+	}
+
+	const_iterator cend() const
+	{
+		return end();
+	}
+
+private:
+	std::vector<source_iterator> m_elements;	// Gathered once, for positional access.
+	size_type m_r;	// 'r' as in nCr.
+	symmetry_group m_group;
+};
@@ -9,20 +9,30 @@
 
 
 #include <algorithm>
+#include <cstddef>
+#include <limits>
 #include <memory>
 #include <set>
+#include <stdexcept>
 #include <utility>
 #include <vector>
 
+#include "atomic_memoized_member.hpp"
 #include "combination_iterator.hpp"
-#include "MemoizedMember.hpp"
+#include "counting.hpp"
+#include "fingerprint.hpp"
+#include "submask_iterator.hpp"
 
 
 using std::rel_ops::operator!=;
 
+/**
+ *  \tparam Source  The container whose subsets are enumerated; see combinations.
+ */
 template<typename Key,
 class Compare = std::less<Key>,
-class Allocator = std::allocator<Key>>
+class Allocator = std::allocator<Key>,
+class Source = std::set<Key, Compare, Allocator>>
 class powerset
 {
 public:
@@ -37,12 +47,13 @@ public:
   using pointer = value_type*;
   using const_pointer = value_type const*;
 
-  using source_iterator = typename value_type::const_iterator;
+  using source_type = Source;
+  using source_iterator = typename source_type::const_iterator;
 
   class const_iterator
   {
   public:
-    using powers_type = typename powerset<Key, Compare, Allocator>;
+    using powers_type = typename powerset<Key, Compare, Allocator, Source>;
     using source_iterator = typename powers_type::source_iterator;
     using mutable_value_type = typename powers_type::key_type;
 
@@ -66,11 +77,13 @@ public:
     {
     }
 
+    /**
+     *  Both the combination size and the combination iterator compare in constant time.
+     *  Comparing iterators from different powerset objects is undefined.
+     */
     bool operator==(const_iterator const& rhs) const
     {
-      return (m_begin == rhs.m_begin)
-        && (m_end == rhs.m_end)
-        && (m_r == rhs.m_r)
+      return (m_r == rhs.m_r)
         && (m_iter == rhs.m_iter);
     }
 
@@ -94,7 +107,7 @@ public:
 
   private:
 
-    using combinations_type = combinations<Key, Compare, Allocator>;
+    using combinations_type = combinations<Key, Compare, Allocator, Source>;
 
 
     void increment()
@@ -127,7 +140,7 @@ public:
 
   using iterator = const_iterator;
 
-  powerset(key_type const& source)
+  powerset(source_type const& source)
     : powerset(source.cbegin(), source.cend())
   {
 
@@ -143,6 +156,8 @@ public:
   powerset(powerset const& rhs)
     : m_begin(rhs.m_begin)
     , m_end(rhs.m_end)
+    , m_source_size(*this, rhs.m_source_size)
+    , m_fingerprint(*this, rhs.m_fingerprint)
     , m_size(*this, rhs.m_size)
   {
 
@@ -152,6 +167,8 @@ public:
   powerset(powerset&& rhs)
     : m_begin(std::move(rhs.m_begin))
     , m_end(std::move(rhs.m_end))
+    , m_source_size(*this, std::move(rhs.m_source_size))
+    , m_fingerprint(*this, std::move(rhs.m_fingerprint))
     , m_size(*this, std::move(rhs.m_size))
   {}
 
@@ -160,10 +177,17 @@ public:
   powerset& operator=(powerset&&) = default;
 
 
+  /**
+   *  @remarks
+   *    See combinations::operator==.  The cached source length and fingerprint settle most
+   *  comparisons in constant time; only equal fingerprints over distinct sources fall back
+   *  to std::equal.
+   */
   bool operator==(const powerset &rhs) const
   {
-    return (size() == rhs.size())
-      && std::equal(m_begin, m_end, rhs.m_begin);
+    return (source_size() == rhs.source_size())
+      && (same_source(rhs)
+        || ((m_fingerprint == rhs.m_fingerprint) && std::equal(m_begin, m_end, rhs.m_begin)));
   }
 
 
@@ -187,22 +211,107 @@ public:
     return const_iterator(m_begin, m_end, true);
   }
   
+  /**
+   * The number of subsets, 2^n.  Finding n may cost on the order of the size of the base
+   * container; see combinations::size().
+   *
+   * \throws std::overflow_error if 2^n does not fit a size_type.
+   */
   size_type size() const
   {
     return m_size;
   }
 
+  /// The number of subsets, however large.
+  big_count exact_size() const
+  {
+    return big_count::power_of_two(source_size());
+  }
+
+  /**
+   * The bitmask of a subset of the source: bit k is set when the k-th source element is a member.
+   * The source must be ordered consistently with Compare, as a std::set is.
+   *
+   * \throws std::length_error if the source has more than 64 elements.
+   * \throws std::invalid_argument if subset has an element that is not in the source.
+   */
+  subset_mask mask_of(value_type const& subset) const
+  {
+    check_mask_width();
+    auto const less = subset.key_comp();
+    auto member = subset.cbegin();
+    subset_mask mask{ 0 };
+    std::size_t k = 0;
+    for (auto i = m_begin; (i != m_end) && (member != subset.cend()); ++i, ++k)
+    {
+      if (!less(*i, *member) && !less(*member, *i))
+      {
+        mask |= subset_mask{ 1 } << k;
+        ++member;
+      }
+    }
+    if (member != subset.cend())
+      throw std::invalid_argument("powerset::mask_of: not a subset of the source");
+    return mask;
+  }
+
+  /**
+   * The subset whose bitmask is mask; the inverse of mask_of().
+   *
+   * \throws std::length_error if the source has more than 64 elements.
+   */
+  value_type subset_of(subset_mask mask) const
+  {
+    check_mask_width();
+    value_type subset;
+    for (auto i = m_begin; (i != m_end) && (mask != 0); ++i, mask >>= 1)
+      if (mask & 1)
+        subset.insert(subset.end(), *i);
+    return subset;
+  }
+
 private:
 
+  size_type source_size() const
+  {
+    return m_source_size;
+  }
+
+  void check_mask_width() const
+  {
+    if (source_size() > static_cast<size_type>(std::numeric_limits<subset_mask>::digits))
+      throw std::length_error("powerset: bitmasks hold at most 64 elements");
+  }
+
+  bool same_source(powerset const& rhs) const
+  {
+    return (m_begin == m_end)
+      || power_iterator_detail::same_element(m_begin, rhs.m_begin);
+  }
+
+  size_type evaluate_source_size() const
+  {
+    return std::distance(m_begin, m_end);
+  }
+
+  std::size_t evaluate_fingerprint() const
+  {
+    return power_iterator_detail::fingerprint(m_begin, m_end);
+  }
+
   size_type evaluate_size() const
   {
-    auto n = std::distance(m_begin, m_end);
+    size_type const n = source_size();
+    if (n >= static_cast<size_type>(std::numeric_limits<size_type>::digits))
+      throw std::overflow_error("powerset::size: too many subsets for size_type");
     return static_cast<size_type>(1) << n;
   }
 
   source_iterator m_begin;
   source_iterator m_end;
-  MemoizedMember<size_type, powerset, &powerset::evaluate_size> m_size{ *this };
+  AtomicMemoizedMember<size_type, powerset, &powerset::evaluate_source_size> m_source_size{ *this };
+  AtomicMemoizedMember<std::size_t, powerset, &powerset::evaluate_fingerprint> m_fingerprint{ *this };
+  AtomicMemoizedMember<size_type, powerset, &powerset::evaluate_size> m_size{ *this };
 };
 
 
@@ -0,0 +1,247 @@
+/**
+*	\author    John Szwast
+*	\year      2014-2016
+*	\copyright MIT
+*/
+
+
+#pragma once
+
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+
+/**
+ *	A virtual container representing the Cartesian product of several sources.
+ *
+ *	Like combinations and powerset, a product does not store its tuples; its iterator
+ *	generates them on demand, odometer style, with the last source varying fastest.
+ *	A source is anything with begin(), size() and a forward const_iterator, which includes
+ *	the standard containers as well as combinations and powerset themselves.
+ *
+ *	Each Source is either an lvalue reference, in which case the product refers to a source
+ *	that must outlive it, or a value type, in which case the product holds its own copy.
+ *	make_product() chooses for you: it refers to lvalues and keeps rvalues, so
+ *	`make_product(combinations<int>(s, 2), t)` holds the lightweight combinations object
+ *	but only refers to t.  The sources must not change while the product is in use.
+ */
+template<typename... Sources>
+class product
+{
+	static constexpr std::size_t dimensions = sizeof...(Sources);
+
+public:
+	using size_type = std::size_t;
+	using difference_type = std::ptrdiff_t;
+
+	class const_iterator
+	{
+	public:
+		using source_iterators = std::tuple<typename std::decay<Sources>::type::const_iterator...>;
+
+		/// Type_traits aliases
+		using difference_type = product::difference_type;
+		/// A tuple of copies of one element of each source, safe to store.
+		using value_type = std::tuple<typename std::decay<Sources>::type::value_type...>;
+		using pointer = void;
+		/// A tuple of the values dereferenced from each source, by reference where the source allows.
+		using reference = std::tuple<typename std::iterator_traits<typename std::decay<Sources>::type::const_iterator>::reference...>;
+		/// Only an input iterator: dereferencing yields a reference tuple by value, not a value_type&.
+		using iterator_category = std::input_iterator_tag;
+
+		/// Iterators over the same product are equal when they are at the same rank.
+		bool operator==(const_iterator const& rhs) const
+		{
+			return m_rank == rhs.m_rank;
+		}
+
+		bool operator!=(const_iterator const& rhs) const
+		{
+			return m_rank != rhs.m_rank;
+		}
+
+		const_iterator& operator++()
+		{
+			increment();
+			return *this;
+		}
+
+		const_iterator operator++(int)
+		{
+			const_iterator temp{ *this };
+			increment();
+			return temp;
+		}
+
+		/// The tuple refers into the sources' iterators, so it is valid until this iterator changes.
+		reference operator*() const
+		{
+			return dereference(std::index_sequence_for<Sources...>{});
+		}
+
+		/// The position of the current tuple in the product, from 0 to size().
+		size_type rank() const
+		{
+			return m_rank;
+		}
+
+	private:
+		friend class product;
+
+		const_iterator(product const& owner, size_type rank)
+			: m_product(&owner)
+			, m_iterators(owner.source_begins(std::index_sequence_for<Sources...>{}))
+			, m_index{}
+			, m_rank(rank)
+		{
+			if (m_rank < m_product->m_size)
+				seek(std::index_sequence_for<Sources...>{});
+		}
+
+		template<std::size_t... I>
+		reference dereference(std::index_sequence<I...>) const
+		{
+			return reference(*std::get<I>(m_iterators)...);
+		}
+
+		/// Positions every source iterator at its digit of m_rank.
+		template<std::size_t... I>
+		void seek(std::index_sequence<I...>)
+		{
+			size_type remaining = m_rank;
+			for (std::size_t d = dimensions; d-- > 0; )
+			{
+				m_index[d] = remaining % m_product->m_sizes[d];
+				remaining /= m_product->m_sizes[d];
+			}
+			using expand = int[];
+			(void)expand{ 0, (std::advance(std::get<I>(m_iterators), static_cast<difference_type>(m_index[I])), 0)... };
+		}
+
+		void increment()
+		{
+			if (m_rank < m_product->m_size)
+			{
+				++m_rank;
+				carry(std::integral_constant<std::size_t, dimensions>{});
+			}
+		}
+
+		/// Carried out of the first source; m_rank has reached size().
+		void carry(std::integral_constant<std::size_t, 0>)
+		{
+		}
+
+		/// Advances source I - 1, wrapping it to its beginning and carrying into source I - 2 at its end.
+		template<std::size_t I>
+		void carry(std::integral_constant<std::size_t, I>)
+		{
+			constexpr std::size_t d = I - 1;
+			++std::get<d>(m_iterators);
+			if (++m_index[d] < m_product->m_sizes[d])
+				return;
+			std::get<d>(m_iterators) = std::get<d>(m_product->m_sources).begin();
+			m_index[d] = 0;
+			carry(std::integral_constant<std::size_t, d>{});
+		}
+
+		product const* m_product;
+		source_iterators m_iterators;
+		std::array<size_type, dimensions> m_index;	// The digits of m_rank, one per source.
+		size_type m_rank;
+	};
+
+	using iterator = const_iterator;
+
+	/// \throws std::overflow_error if the number of tuples does not fit a size_type.
+	explicit product(Sources... sources)
+		: m_sources(std::forward<Sources>(sources)...)
+		, m_sizes(source_sizes(std::index_sequence_for<Sources...>{}))
+		, m_size(1)
+	{
+		// An empty source empties the product, however large the others are.
+		for (auto dimension : m_sizes)
+			if (dimension == 0)
+			{
+				m_size = 0;
+				return;
+			}
+		for (auto dimension : m_sizes)
+		{
+			if (m_size > std::numeric_limits<size_type>::max() / dimension)
+				throw std::overflow_error("product::size: too many tuples for size_type");
+			m_size *= dimension;
+		}
+	}
+
+	const_iterator begin() const
+	{
+		return const_iterator(*this, 0);
+	}
+
+	const_iterator cbegin() const
+	{
+		return begin();
+	}
+
+	const_iterator end() const
+	{
+		return const_iterator(*this, m_size);
+	}
+
+	const_iterator cend() const
+	{
+		return end();
+	}
+
+	/**
+	 *	An iterator to the tuple of the given rank; the inverse of const_iterator::rank().
+	 *	Each source iterator is advanced to its digit of the rank, which takes constant time
+	 *	for random-access sources and time proportional to the digit otherwise.
+	 *
+	 *	\throws std::out_of_range if rank > size().
+	 */
+	const_iterator at(size_type rank) const
+	{
+		if (rank > m_size)
+			throw std::out_of_range("product::at: rank out of range");
+		return const_iterator(*this, rank);
+	}
+
+	size_type size() const
+	{
+		return m_size;
+	}
+
+private:
+
+	template<std::size_t... I>
+	std::array<size_type, dimensions> source_sizes(std::index_sequence<I...>) const
+	{
+		return std::array<size_type, dimensions>{ { static_cast<size_type>(std::get<I>(m_sources).size())... } };
+	}
+
+	template<std::size_t... I>
+	typename const_iterator::source_iterators source_begins(std::index_sequence<I...>) const
+	{
+		return typename const_iterator::source_iterators(std::get<I>(m_sources).begin()...);
+	}
+
+	std::tuple<Sources...> m_sources;
+	std::array<size_type, dimensions> m_sizes;
+	size_type m_size;
+};
+
+
+template<typename... Sources>
+product<Sources...> make_product(Sources&&... sources)
+{
+	return product<Sources...>(std::forward<Sources>(sources)...);
+}
@@ -0,0 +1,312 @@
+/**
+*	\author    John Szwast
+*	\year      2014-2016
+*	\copyright MIT
+*/
+
+
+#pragma once
+
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <unordered_set>
+#include <vector>
+
+#include "counting.hpp"
+#include "fingerprint.hpp"
+
+
+/// Whether a batch of samples may contain the same subset more than once.
+enum class sampling
+{
+	with_replacement,
+	without_replacement
+};
+
+
+namespace power_iterator_detail
+{
+
+	/**
+	 *	A uniform integer in [0, bound).  Uses Lemire's multiply-and-shift method when bound fits
+	 *	32 bits and the generator yields exactly 32 or 64 uniform bits, so that its low 32 bits are
+	 *	uniform; that avoids the divisions of std::uniform_int_distribution, which handles every
+	 *	other generator.
+	 */
+	template<typename Size, typename URBG>
+	Size uniform_below(URBG& g, Size bound)
+	{
+		constexpr bool full_width = (URBG::min() == 0)
+			&& ((static_cast<std::uint64_t>(URBG::max()) == 0xffffffffu)
+				|| (static_cast<std::uint64_t>(URBG::max()) == std::numeric_limits<std::uint64_t>::max()));
+		if (full_width && (static_cast<std::uint64_t>(bound) <= 0xffffffffu))
+		{
+			std::uint32_t const b = static_cast<std::uint32_t>(bound);
+			std::uint64_t m = std::uint64_t{ static_cast<std::uint32_t>(g()) } * b;
+			if (static_cast<std::uint32_t>(m) < b)
+			{
+				std::uint32_t const threshold = (0u - b) % b;
+				while (static_cast<std::uint32_t>(m) < threshold)
+					m = std::uint64_t{ static_cast<std::uint32_t>(g()) } * b;
+			}
+			return static_cast<Size>(m >> 32);
+		}
+		return std::uniform_int_distribution<Size>{ 0, bound - 1 }(g);
+	}
+
+
+	struct vector_hash
+	{
+		template<typename T>
+		std::size_t operator()(std::vector<T> const& v) const
+		{
+			std::size_t seed{ v.size() };
+			for (auto x : v)
+				seed = hash_combine(seed, std::hash<T>{}(x));
+			return seed;
+		}
+	};
+
+}
+
+
+/**
+ *	Draws uniformly random combinations of r elements of a source, without enumerating them.
+ *
+ *	Each draw uses Floyd's algorithm: r calls to the random bit generator and O(r^2) work in
+ *	the worst case, independent of the number of combinations.  Samples are reported either as
+ *	value_type sets or, for batches, as ascending source indices; a batch of indices drawn
+ *	with replacement allocates nothing per sample.
+ *	The source iterators are gathered once at construction so that indices map to elements
+ *	in constant time.
+ */
+template<typename Key,
+	class Compare = std::less<Key>,
+	class Allocator = std::allocator<Key>>
+	class combination_sampler
+{
+public:
+	using value_type = std::set<Key, Compare, Allocator>;
+	using size_type = typename value_type::size_type;
+	using source_iterator = typename value_type::const_iterator;
+
+	combination_sampler(value_type const& source, size_type r)
+		: combination_sampler(source.begin(), source.end(), r)
+	{
+
+	}
+
+	/// \throws std::invalid_argument if r exceeds the size of the source.
+	combination_sampler(source_iterator source_begin, source_iterator source_end, size_type r)
+		: m_r(r)
+	{
+		for (; source_begin != source_end; ++source_begin)
+			m_elements.push_back(source_begin);
+		if (m_r > m_elements.size())
+			throw std::invalid_argument("combination_sampler: r exceeds the size of the source");
+	}
+
+	size_type r() const
+	{
+		return m_r;
+	}
+
+	/// Draws one combination.
+	template<typename URBG>
+	value_type operator()(URBG& g) const
+	{
+		std::vector<size_type> indices(m_r);
+		draw(g, indices.data());
+		value_type result;
+		for (auto i : indices)
+			result.insert(result.end(), *m_elements[i]);
+		return result;
+	}
+
+	/**
+	 *	Writes the ascending source indices of `count` combinations to out, r indices per sample.
+	 *	Without replacement, no combination appears twice in the batch; the combinations drawn so
+	 *	far are kept in a hash set, which allocates a node per sample.
+	 *
+	 *	\throws std::invalid_argument if sampling without replacement and count exceeds nCr.
+	 */
+	template<typename URBG, typename OutputIt>
+	OutputIt fill_indices(URBG& g, size_type count, OutputIt out,
+		sampling replacement = sampling::with_replacement) const
+	{
+		std::vector<size_type> indices(m_r);
+		if (replacement == sampling::with_replacement)
+		{
+			for (size_type s = 0; s < count; ++s)
+			{
+				draw(g, indices.data());
+				out = std::copy(indices.begin(), indices.end(), out);
+			}
+			return out;
+		}
+
+		std::uint64_t available;
+		if (checked_binomial(m_elements.size(), m_r, available) && (count > available))
+			throw std::invalid_argument("combination_sampler: more samples requested than there are combinations");
+
+		std::unordered_set<std::vector<size_type>, power_iterator_detail::vector_hash> seen;
+		seen.reserve(count);
+		while (seen.size() < count)
+		{
+			draw(g, indices.data());
+			if (seen.insert(indices).second)
+				out = std::copy(indices.begin(), indices.end(), out);
+		}
+		return out;
+	}
+
+	/// Appends `count` combinations to out as value_type sets, each of which allocates its nodes.
+	template<typename URBG, typename OutputIt>
+	OutputIt fill(URBG& g, size_type count, OutputIt out,
+		sampling replacement = sampling::with_replacement) const
+	{
+		std::vector<size_type> indices(count * m_r);
+		fill_indices(g, count, indices.begin(), replacement);
+		// Count samples, not indices: with r == 0 every sample is an empty set and has none.
+		auto sample = indices.cbegin();
+		for (size_type s = 0; s < count; ++s)
+		{
+			value_type result;
+			for (size_type i = 0; i < m_r; ++i)
+				result.insert(result.end(), *m_elements[*sample++]);
+			*out++ = std::move(result);
+		}
+		return out;
+	}
+
+private:
+
+	/**
+	 *	Floyd's algorithm, keeping the chosen indices sorted in out[0, r).
+	 *	For j from n-r to n-1, pick t uniformly from [0, j]; take t unless it is already taken,
+	 *	in which case take j, which cannot be.
+	 */
+	template<typename URBG>
+	void draw(URBG& g, size_type* out) const
+	{
+		size_type const n = m_elements.size();
+		size_type taken = 0;
+		for (size_type j = n - m_r; j < n; ++j)
+		{
+			size_type t = power_iterator_detail::uniform_below<size_type>(g, j + 1);
+			size_type* position = std::lower_bound(out, out + taken, t);
+			if ((position != out + taken) && (*position == t))
+			{
+				// j exceeds everything chosen so far.
+				out[taken++] = j;
+			}
+			else
+			{
+				std::copy_backward(position, out + taken, out + taken + 1);
+				*position = t;
+				++taken;
+			}
+		}
+	}
+
+	std::vector<source_iterator> m_elements;
+	size_type m_r;
+};
+
+
+/**
+ *	Draws uniformly random subsets of a source, i.e. uniform members of its powerset.
+ *
+ *	Every element is kept with probability one half, 64 elements per call to the generator.
+ *	Batches are reported as bitmasks (bit k for the k-th source element), so they require
+ *	a source of at most 64 elements; single draws as value_type work for any source.
+ */
+template<typename Key,
+	class Compare = std::less<Key>,
+	class Allocator = std::allocator<Key>>
+	class subset_sampler
+{
+public:
+	using value_type = std::set<Key, Compare, Allocator>;
+	using size_type = typename value_type::size_type;
+	using source_iterator = typename value_type::const_iterator;
+	using mask_type = std::uint64_t;
+
+	subset_sampler(value_type const& source)
+		: subset_sampler(source.begin(), source.end())
+	{
+
+	}
+
+	subset_sampler(source_iterator source_begin, source_iterator source_end)
+	{
+		for (; source_begin != source_end; ++source_begin)
+			m_elements.push_back(source_begin);
+	}
+
+	/// Draws one subset.
+	template<typename URBG>
+	value_type operator()(URBG& g) const
+	{
+		value_type result;
+		std::uniform_int_distribution<mask_type> bits;
+		for (size_type base = 0; base < m_elements.size(); base += 64)
+		{
+			mask_type word = bits(g);
+			for (size_type i = base; (i < base + 64) && (i < m_elements.size()); ++i, word >>= 1)
+				if (word & 1)
+					result.insert(result.end(), *m_elements[i]);
+		}
+		return result;
+	}
+
+	/**
+	 *	Writes `count` subsets to out as bitmasks.
+	 *	Without replacement, no subset appears twice in the batch; the masks drawn so far are
+	 *	kept in a hash set, which allocates a node per sample.
+	 *
+	 *	\throws std::length_error if the source has more than 64 elements.
+	 *	\throws std::invalid_argument if sampling without replacement and count exceeds 2^n.
+	 */
+	template<typename URBG, typename OutputIt>
+	OutputIt fill_masks(URBG& g, size_type count, OutputIt out,
+		sampling replacement = sampling::with_replacement) const
+	{
+		size_type const n = m_elements.size();
+		if (n > 64)
+			throw std::length_error("subset_sampler: bitmasks hold at most 64 elements");
+		mask_type const full = (n == 64) ? ~mask_type{ 0 } : ((mask_type{ 1 } << n) - 1);
+		std::uniform_int_distribution<mask_type> bits;
+
+		if (replacement == sampling::with_replacement)
+		{
+			for (size_type s = 0; s < count; ++s)
+				*out++ = bits(g) & full;
+			return out;
+		}
+
+		if ((n < 64) && (count > full + 1))
+			throw std::invalid_argument("subset_sampler: more samples requested than there are subsets");
+
+		std::unordered_set<mask_type> seen;
+		seen.reserve(count);
+		while (seen.size() < count)
+		{
+			mask_type mask = bits(g) & full;
+			if (seen.insert(mask).second)
+				*out++ = mask;
+		}
+		return out;
+	}
+
+private:
+
+	std::vector<source_iterator> m_elements;
+};
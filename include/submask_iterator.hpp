@@ -0,0 +1,299 @@
+/**
+*	\author    John Szwast
+*	\year      2014-2016
+*	\copyright MIT
+*/
+
+
+#pragma once
+
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+
+
+/**
+ *	Views of all subsets, or all supersets, of one subset of a powerset's source.
+ *
+ *	Subsets are bitmasks as in subset_transform.hpp: bit k is set when the k-th source element
+ *	is a member.  powerset::mask_of() and powerset::subset_of() convert to and from value_type.
+ *	The iterators hold only masks, so a walk never allocates, and each step is a couple of
+ *	integer operations.
+ */
+
+
+using subset_mask = std::uint64_t;
+
+
+namespace power_iterator_detail
+{
+
+	inline std::size_t popcount(subset_mask mask)
+	{
+		std::size_t count = 0;
+		for (; mask != 0; mask &= mask - 1)
+			++count;
+		return count;
+	}
+
+	/// 2^bits, the number of subsets of a set of that many elements.
+	inline std::size_t subset_count(std::size_t bits)
+	{
+		if (bits >= static_cast<std::size_t>(std::numeric_limits<std::size_t>::digits))
+			throw std::overflow_error("too many subsets for std::size_t");
+		return std::size_t{ 1 } << bits;
+	}
+
+}
+
+
+/**
+ *	Every submask of a mask, from the mask itself down to 0, with the usual (s - 1) & mask step.
+ */
+class submasks
+{
+public:
+	using value_type = subset_mask;
+	using size_type = std::size_t;
+
+	class const_iterator
+	{
+	public:
+		/// Type_traits aliases
+		using difference_type = std::ptrdiff_t;
+		using value_type = subset_mask;
+		using pointer = value_type const*;
+		using reference = value_type const&;
+		using iterator_category = std::forward_iterator_tag;
+
+		const_iterator(subset_mask mask, bool end)
+			: m_mask(mask)
+			, m_current(end ? 0 : mask)
+			, m_at_end(end)
+		{
+
+		}
+
+		bool operator==(const_iterator const& rhs) const
+		{
+			return (m_at_end == rhs.m_at_end)
+				&& (m_at_end || (m_current == rhs.m_current));
+		}
+
+		bool operator!=(const_iterator const& rhs) const
+		{
+			return !(*this == rhs);
+		}
+
+		const_iterator& operator++()
+		{
+			increment();
+			return *this;
+		}
+
+		const_iterator operator++(int)
+		{
+			const_iterator temp{ *this };
+			increment();
+			return temp;
+		}
+
+		reference operator*() const
+		{
+			return m_current;
+		}
+
+	private:
+
+		void increment()
+		{
+			if (m_current == 0)
+				m_at_end = true;
+			else
+				m_current = (m_current - 1) & m_mask;
+		}
+
+		subset_mask m_mask;
+		subset_mask m_current;
+		bool m_at_end;	// 0 is the last submask, so it cannot also mark the end.
+	};
+
+	using iterator = const_iterator;
+
+	explicit submasks(subset_mask mask)
+		: m_mask(mask)
+	{
+
+	}
+
+	const_iterator begin() const
+	{
+		return const_iterator(m_mask, false);
+	}
+
+	const_iterator cbegin() const
+	{
+		return begin();
+	}
+
+	const_iterator end() const
+	{
+		return const_iterator(m_mask, true);
+	}
+
+	const_iterator cend() const
+	{
+		return end();
+	}
+
+	/// 2^popcount(mask).  \throws std::overflow_error if that does not fit a size_type.
+	size_type size() const
+	{
+		return power_iterator_detail::subset_count(power_iterator_detail::popcount(m_mask));
+	}
+
+private:
+	subset_mask m_mask;
+};
+
+
+/**
+ *	Every superset of a mask within a source of n elements, from the mask itself up to the
+ *	full set, with the dual (s + 1) | mask step.
+ */
+class supersets
+{
+public:
+	using value_type = subset_mask;
+	using size_type = std::size_t;
+
+	class const_iterator
+	{
+	public:
+		/// Type_traits aliases
+		using difference_type = std::ptrdiff_t;
+		using value_type = subset_mask;
+		using pointer = value_type const*;
+		using reference = value_type const&;
+		using iterator_category = std::forward_iterator_tag;
+
+		const_iterator(subset_mask mask, subset_mask full, bool end)
+			: m_mask(mask)
+			, m_full(full)
+			, m_current(end ? full : mask)
+			, m_at_end(end)
+		{
+
+		}
+
+		bool operator==(const_iterator const& rhs) const
+		{
+			return (m_at_end == rhs.m_at_end)
+				&& (m_at_end || (m_current == rhs.m_current));
+		}
+
+		bool operator!=(const_iterator const& rhs) const
+		{
+			return !(*this == rhs);
+		}
+
+		const_iterator& operator++()
+		{
+			increment();
+			return *this;
+		}
+
+		const_iterator operator++(int)
+		{
+			const_iterator temp{ *this };
+			increment();
+			return temp;
+		}
+
+		reference operator*() const
+		{
+			return m_current;
+		}
+
+	private:
+
+		void increment()
+		{
+			if (m_current == m_full)
+				m_at_end = true;
+			else
+				m_current = (m_current + 1) | m_mask;
+		}
+
+		subset_mask m_mask;
+		subset_mask m_full;
+		subset_mask m_current;
+		bool m_at_end;	// The full set is the last superset, so it cannot also mark the end.
+	};
+
+	using iterator = const_iterator;
+
+	/**
+	 *	\throws std::length_error if n > 64.
+	 *	\throws std::invalid_argument if mask has bits outside the n-element source.
+	 */
+	supersets(subset_mask mask, std::size_t n)
+		: m_mask(mask)
+		, m_n(n)
+	{
+		if (m_n > static_cast<std::size_t>(std::numeric_limits<subset_mask>::digits))
+			throw std::length_error("supersets: masks hold at most 64 elements");
+		m_full = (m_n == static_cast<std::size_t>(std::numeric_limits<subset_mask>::digits))
+			? ~subset_mask{ 0 }
+			: ((subset_mask{ 1 } << m_n) - 1);
+		if ((m_mask & ~m_full) != 0)
+			throw std::invalid_argument("supersets: mask is not a subset of the source");
+	}
+
+	const_iterator begin() const
+	{
+		return const_iterator(m_mask, m_full, false);
+	}
+
+	const_iterator cbegin() const
+	{
+		return begin();
+	}
+
+	const_iterator end() const
+	{
+		return const_iterator(m_mask, m_full, true);
+	}
+
+	const_iterator cend() const
+	{
+		return end();
+	}
+
+	/// 2^(n - popcount(mask)).  \throws std::overflow_error if that does not fit a size_type.
+	size_type size() const
+	{
+		return power_iterator_detail::subset_count(m_n - power_iterator_detail::popcount(m_mask));
+	}
+
+private:
+	subset_mask m_mask;
+	std::size_t m_n;
+	subset_mask m_full;
+};
+
+
+inline submasks submasks_of(subset_mask mask)
+{
+	return submasks(mask);
+}
+
+
+/// \see supersets::supersets()
+inline supersets supersets_of(subset_mask mask, std::size_t n)
+{
+	return supersets(mask, n);
+}
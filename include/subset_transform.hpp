@@ -0,0 +1,258 @@
+/**
+*	\author    John Szwast
+*	\year      2014-2016
+*	\copyright MIT
+*/
+
+
+#pragma once
+
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+
+/**
+ *	Sum-over-subsets transforms on the power set lattice.
+ *
+ *	The data is a dense array of 2^n values indexed by bitmask: bit k of an index is set when
+ *	the k-th element (in source order) of a powerset's source is in the subset.
+ *	The zeta transform replaces every value with the aggregate over all of its subsets
+ *	(or supersets), and the Mobius transform undoes it.  Both cost O(n 2^n) instead of the
+ *	O(3^n) of enumerating each subset's subsets.
+ *
+ *	The aggregate is chosen with a semiring policy.  Min, max and or are idempotent and so have
+ *	no Mobius inverse; only policies providing uncombine() can be used with mobius_transform.
+ */
+
+
+struct sum_semiring
+{
+	template<typename T> static T combine(T a, T b) { return a + b; }
+	template<typename T> static T uncombine(T a, T b) { return a - b; }
+};
+
+struct min_semiring
+{
+	template<typename T> static T combine(T a, T b) { return std::min(a, b); }
+};
+
+struct max_semiring
+{
+	template<typename T> static T combine(T a, T b) { return std::max(a, b); }
+};
+
+struct or_semiring
+{
+	template<typename T> static T combine(T a, T b) { return a | b; }
+};
+
+
+/// Whether each mask aggregates over its subsets or over its supersets.
+enum class lattice_direction
+{
+	subsets,
+	supersets
+};
+
+
+namespace power_iterator_detail
+{
+
+	struct zeta_step
+	{
+		template<typename Semiring, typename T>
+		static T apply(T a, T b) { return Semiring::combine(a, b); }
+	};
+
+	struct mobius_step
+	{
+		template<typename Semiring, typename T>
+		static T apply(T a, T b) { return Semiring::uncombine(a, b); }
+	};
+
+
+	/**
+	 *	Applies the transform for bits [0, bits) to the contiguous block starting at data.
+	 *	The inner loop runs over 2^bit adjacent elements so that the compiler can vectorize it.
+	 */
+	template<typename Step, typename Semiring, typename T>
+	void transform_low_bits(T* data, unsigned bits, lattice_direction direction)
+	{
+		std::size_t const size = std::size_t{ 1 } << bits;
+		for (std::size_t half = 1; half < size; half <<= 1)
+		{
+			for (std::size_t base = 0; base < size; base += 2 * half)
+			{
+				T* lo = data + base;
+				T* hi = lo + half;
+				if (direction == lattice_direction::subsets)
+					for (std::size_t j = 0; j < half; ++j)
+						hi[j] = Step::template apply<Semiring>(hi[j], lo[j]);
+				else
+					for (std::size_t j = 0; j < half; ++j)
+						lo[j] = Step::template apply<Semiring>(lo[j], hi[j]);
+			}
+		}
+	}
+
+
+	/**
+	 *	Applies the transform for `bits` consecutive high bits to one tile.
+	 *	The tile has 2^bits rows, `stride` elements apart, of `width` contiguous columns,
+	 *	so the working set stays in cache while every one of the bits is applied.
+	 */
+	template<typename Step, typename Semiring, typename T>
+	void transform_tile(T* data, std::size_t stride, unsigned bits, std::size_t width, lattice_direction direction)
+	{
+		std::size_t const rows = std::size_t{ 1 } << bits;
+		for (std::size_t half = 1; half < rows; half <<= 1)
+		{
+			for (std::size_t base = 0; base < rows; base += 2 * half)
+			{
+				for (std::size_t row = base; row < base + half; ++row)
+				{
+					T* lo = data + row * stride;
+					T* hi = lo + half * stride;
+					if (direction == lattice_direction::subsets)
+						for (std::size_t j = 0; j < width; ++j)
+							hi[j] = Step::template apply<Semiring>(hi[j], lo[j]);
+					else
+						for (std::size_t j = 0; j < width; ++j)
+							lo[j] = Step::template apply<Semiring>(lo[j], hi[j]);
+				}
+			}
+		}
+	}
+
+
+	/// Runs task(0) ... task(count - 1), striped over up to `threads` threads.
+	template<typename Task>
+	void parallel_for(std::size_t count, unsigned threads, Task const& task)
+	{
+		threads = static_cast<unsigned>(std::min<std::size_t>(threads, count));
+		if (threads <= 1)
+		{
+			for (std::size_t i = 0; i < count; ++i)
+				task(i);
+			return;
+		}
+
+		std::vector<std::thread> workers;
+		workers.reserve(threads - 1);
+		auto stripe = [&](unsigned t)
+		{
+			for (std::size_t i = t; i < count; i += threads)
+				task(i);
+		};
+		for (unsigned t = 1; t < threads; ++t)
+			workers.emplace_back(stripe, t);
+		stripe(0);
+		for (auto& worker : workers)
+			worker.join();
+	}
+
+
+	/// log2 of the number of elements processed together; 2^13 doubles are 64 KiB.
+	template<typename T>
+	constexpr unsigned block_bits()
+	{
+		return sizeof(T) <= 4 ? 14 : sizeof(T) <= 8 ? 13 : 11;
+	}
+
+
+	template<typename Step, typename Semiring, typename T>
+	void lattice_transform(T* data, unsigned n, lattice_direction direction, unsigned threads)
+	{
+		if (threads == 0)
+			threads = std::max(1u, std::thread::hardware_concurrency());
+		// Thread start-up costs more than the whole transform of a small array.
+		if (n < 16)
+			threads = 1;
+
+		unsigned const block = std::min(n, block_bits<T>());
+
+		// Bits below `block`: each block of 2^block elements is transformed independently.
+		parallel_for(std::size_t{ 1 } << (n - block), threads, [=](std::size_t b)
+		{
+			transform_low_bits<Step, Semiring>(data + (b << block), block, direction);
+		});
+
+		// Higher bits, a few at a time, in tiles of 2^block elements.
+		unsigned const group = std::max(1u, block / 2);
+		for (unsigned low = block; low < n; low += group)
+		{
+			unsigned const bits = std::min(group, n - low);
+			std::size_t const stride = std::size_t{ 1 } << low;
+			std::size_t const width = std::min(stride, std::size_t{ 1 } << (block - bits));
+			std::size_t const columns = stride / width;
+			std::size_t const outer = std::size_t{ 1 } << (n - low - bits);
+
+			parallel_for(outer * columns, threads, [=](std::size_t tile)
+			{
+				T* origin = data + ((tile / columns) << (low + bits)) + (tile % columns) * width;
+				transform_tile<Step, Semiring>(origin, stride, bits, width, direction);
+			});
+		}
+	}
+
+
+	template<typename T, typename Allocator>
+	unsigned lattice_bits(std::vector<T, Allocator> const& data)
+	{
+		unsigned n = 0;
+		while ((std::size_t{ 1 } << n) < data.size())
+			++n;
+		if ((std::size_t{ 1 } << n) != data.size())
+			throw std::invalid_argument("lattice transform requires a power-of-two number of values");
+		return n;
+	}
+
+}
+
+
+/**
+ *	In-place zeta transform of the 2^n values at data.
+ *	Afterwards data[mask] aggregates, with Semiring::combine, the original values of every
+ *	subset (or superset) of mask, mask included.
+ *
+ *	\param threads	Worker threads to use; 0 uses the hardware concurrency.
+ */
+template<typename Semiring = sum_semiring, typename T>
+void zeta_transform(T* data, unsigned n,
+	lattice_direction direction = lattice_direction::subsets, unsigned threads = 0)
+{
+	power_iterator_detail::lattice_transform<power_iterator_detail::zeta_step, Semiring>(
+		data, n, direction, threads);
+}
+
+
+/// Inverse of zeta_transform.  Requires a Semiring with uncombine().
+template<typename Semiring = sum_semiring, typename T>
+void mobius_transform(T* data, unsigned n,
+	lattice_direction direction = lattice_direction::subsets, unsigned threads = 0)
+{
+	power_iterator_detail::lattice_transform<power_iterator_detail::mobius_step, Semiring>(
+		data, n, direction, threads);
+}
+
+
+/// \throws std::invalid_argument if data.size() is not a power of two.
+template<typename Semiring = sum_semiring, typename T, typename Allocator>
+void zeta_transform(std::vector<T, Allocator>& data,
+	lattice_direction direction = lattice_direction::subsets, unsigned threads = 0)
+{
+	zeta_transform<Semiring>(data.data(), power_iterator_detail::lattice_bits(data), direction, threads);
+}
+
+
+/// \throws std::invalid_argument if data.size() is not a power of two.
+template<typename Semiring = sum_semiring, typename T, typename Allocator>
+void mobius_transform(std::vector<T, Allocator>& data,
+	lattice_direction direction = lattice_direction::subsets, unsigned threads = 0)
+{
+	mobius_transform<Semiring>(data.data(), power_iterator_detail::lattice_bits(data), direction, threads);
+}
@@ -7,7 +7,12 @@
 
 #include "gtest/gtest.h"
 #include "combination_iterator.hpp"
+#include <cstddef>
+#include <iterator>
 #include <set>
+#include <string>
+#include <thread>
+#include <vector>
 
 
 TEST(combinations_construction, construction_from_set)
@@ -112,6 +117,87 @@ TEST(combinations_equality, equally_constructed)
 }
 
 
+TEST(combinations_equality, unhashable_key)
+{
+	struct point
+	{
+		int x;
+		bool operator<(point const& rhs) const { return x < rhs.x; }
+		bool operator==(point const& rhs) const { return x == rhs.x; }
+	};
+
+	std::set<point> s1{ {1}, {2}, {3} };
+	std::set<point> s2{ s1 };
+	std::set<point> s3{ {1}, {2}, {4} };
+	EXPECT_TRUE((combinations<point>{ s1, 2 } == combinations<point>{ s2, 2 }));
+	EXPECT_FALSE((combinations<point>{ s1, 2 } == combinations<point>{ s3, 2 }));
+}
+
+
+namespace
+{
+	/// A by-value view into a shared buffer, compared by content.
+	struct text_view
+	{
+		char const* m_data;
+		std::size_t m_size;
+
+		char const* data() const { return m_data; }
+		bool operator<(text_view const& rhs) const { return std::string(m_data, m_size) < std::string(rhs.m_data, rhs.m_size); }
+		bool operator==(text_view const& rhs) const { return std::string(m_data, m_size) == std::string(rhs.m_data, rhs.m_size); }
+	};
+
+	/// A source whose iterators yield text_view temporaries.
+	class text_views
+	{
+	public:
+		class const_iterator
+		{
+		public:
+			using difference_type = std::ptrdiff_t;
+			using value_type = text_view;
+			using pointer = void;
+			using reference = text_view;
+			using iterator_category = std::bidirectional_iterator_tag;
+
+			const_iterator() = default;
+			explicit const_iterator(std::vector<text_view>::const_iterator i) : m_i(i) {}
+
+			reference operator*() const { return *m_i; }
+			const_iterator& operator++() { ++m_i; return *this; }
+			const_iterator operator++(int) { const_iterator temp{ *this }; ++m_i; return temp; }
+			const_iterator& operator--() { --m_i; return *this; }
+			const_iterator operator--(int) { const_iterator temp{ *this }; --m_i; return temp; }
+			bool operator==(const_iterator const& rhs) const { return m_i == rhs.m_i; }
+			bool operator!=(const_iterator const& rhs) const { return m_i != rhs.m_i; }
+
+		private:
+			std::vector<text_view>::const_iterator m_i;
+		};
+
+		explicit text_views(std::vector<text_view> views) : m_views(std::move(views)) {}
+
+		const_iterator begin() const { return const_iterator(m_views.begin()); }
+		const_iterator end() const { return const_iterator(m_views.end()); }
+
+	private:
+		std::vector<text_view> m_views;
+	};
+}
+
+
+TEST(combinations_equality, views_sharing_storage)
+{
+	// Both sources start with a view of the same buffer, but are not the same source.
+	char const buffer[] = "abc";
+	text_views a{ { { buffer, 1 }, { "x", 1 } } };
+	text_views b{ { { buffer, 3 }, { "y", 1 } } };
+	using text_combinations = combinations<text_view, std::less<text_view>, std::allocator<text_view>, text_views>;
+	EXPECT_FALSE((text_combinations{ a, 1 } == text_combinations{ b, 1 }));
+	EXPECT_TRUE((text_combinations{ a, 1 } == text_combinations{ a, 1 }));
+}
+
+
 TEST(combinations_utility, size)
 {
 	std::set<double> s1{0.0, 1.0, 4.0};
@@ -123,6 +209,34 @@ TEST(combinations_utility, size)
 
 
 
+TEST(combinations_utility, concurrent_size)
+{
+	std::set<int> s;
+	for (int i = 0; i < 40; ++i)
+		s.insert(i);
+	combinations<int> const shared{ s, 5 };
+	combinations<int> const other{ s, 5 };
+
+	std::vector<combinations<int>::size_type> sizes(8);
+	std::vector<char> equal(sizes.size());
+	std::vector<std::thread> threads;
+	for (std::size_t t = 0; t < sizes.size(); ++t)
+		threads.emplace_back([&, t]
+		{
+			sizes[t] = shared.size();
+			equal[t] = (shared == other);
+		});
+	for (auto& thread : threads)
+		thread.join();
+
+	for (std::size_t t = 0; t < sizes.size(); ++t)
+	{
+		EXPECT_EQ(658008u, sizes[t]);
+		EXPECT_TRUE(equal[t]);
+	}
+}
+
+
 
 TEST(combination_iterator_construction, construction_from_combinations)
 {
@@ -211,3 +325,19 @@ TEST(combination_iterator_navigation, union_to_whole)
 
 	EXPECT_EQ(s, union_of_subs);
 }
+
+
+TEST(combination_iterator_navigation, iterator_equality)
+{
+	std::set<int> s{0, 1, 2, 3, 4};
+	combinations<int> test{s.begin(), s.end(), 3};
+
+	auto lagging = test.begin();
+	for (auto leading = test.begin(); leading != test.end(); ++leading, ++lagging)
+	{
+		EXPECT_EQ(leading, lagging);
+		auto ahead = leading;
+		EXPECT_NE(++ahead, lagging);
+	}
+	EXPECT_EQ(test.end(), lagging);
+}
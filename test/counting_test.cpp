@@ -0,0 +1,75 @@
+/**
+*	\author    John Szwast
+*	\year      2014-2016
+*	\copyright MIT
+*/
+
+
+#include "gtest/gtest.h"
+#include "counting.hpp"
+#include "combination_iterator.hpp"
+#include "power_iterator.hpp"
+#include <cstdint>
+#include <set>
+
+
+TEST(Counting, CheckedBinomial)
+{
+	std::uint64_t c;
+	ASSERT_TRUE(checked_binomial(5, 2, c));
+	EXPECT_EQ(10u, c);
+	ASSERT_TRUE(checked_binomial(3, 5, c));
+	EXPECT_EQ(0u, c);
+	ASSERT_TRUE(checked_binomial(67, 33, c));
+	EXPECT_EQ(14226520737620288370ull, c);
+	ASSERT_TRUE(checked_binomial(200, 10, c));
+	EXPECT_EQ(22451004309013280ull, c);
+	ASSERT_TRUE(checked_binomial(200, 190, c));
+	EXPECT_EQ(22451004309013280ull, c);
+
+	EXPECT_FALSE(checked_binomial(68, 34, c));
+	EXPECT_FALSE(checked_binomial(1000, 100, c));
+}
+
+
+TEST(Counting, ExactBinomial)
+{
+	EXPECT_EQ("10", exact_binomial(5, 3).to_string());
+	EXPECT_EQ("100891344545564193334812497256", exact_binomial(100, 50).to_string());
+	EXPECT_EQ("93759702772827452793193754439064084879232655700081358920472352712975170021839591675861424",
+		exact_binomial(300, 150).to_string());
+
+	auto small = exact_binomial(67, 33);
+	EXPECT_TRUE(small.fits<std::uint64_t>());
+	EXPECT_EQ(14226520737620288370ull, small.to<std::uint64_t>());
+	EXPECT_FALSE(exact_binomial(68, 34).fits<std::uint64_t>());
+}
+
+
+TEST(Counting, BigCount)
+{
+	EXPECT_EQ("0", big_count{}.to_string());
+	EXPECT_EQ("18446744073709551616", big_count::power_of_two(64).to_string());
+	EXPECT_EQ(65u, big_count::power_of_two(64).bit_width());
+	EXPECT_TRUE(big_count{ 5 } < big_count::power_of_two(3));
+	EXPECT_TRUE(big_count::power_of_two(3) == big_count{ 8 });
+}
+
+
+TEST(Counting, SizeOverflow)
+{
+	std::set<int> s;
+	for (int i = 0; i < 70; ++i)
+		s.insert(i);
+
+	combinations<int> huge{ s, 35 };
+	EXPECT_THROW(huge.size(), std::overflow_error);
+	EXPECT_EQ(exact_binomial(70, 35), huge.exact_size());
+
+	combinations<int> small{ s, 3 };
+	EXPECT_EQ(54740u, small.size());
+
+	powerset<int> power{ s };
+	EXPECT_THROW(power.size(), std::overflow_error);
+	EXPECT_EQ(big_count::power_of_two(70), power.exact_size());
+}
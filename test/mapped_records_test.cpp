@@ -0,0 +1,125 @@
+/**
+*	\author    John Szwast
+*	\year      2014-2016
+*	\copyright MIT
+*/
+
+
+#include "gtest/gtest.h"
+#include "mapped_records.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include <string>
+#include <system_error>
+#include <vector>
+
+
+namespace
+{
+	class MappedRecords : public ::testing::Test
+	{
+	protected:
+		void SetUp() override
+		{
+			std::ofstream file(path, std::ios::binary);
+			for (std::int32_t value : values)
+				file.write(reinterpret_cast<char const*>(&value), sizeof(value));
+		}
+
+		void TearDown() override
+		{
+			std::remove(path.c_str());
+		}
+
+		std::string const path{ "mapped_records_test.bin" };
+		std::vector<std::int32_t> const values{ 5, -1, 7, 7, 0, 42 };
+	};
+}
+
+
+TEST_F(MappedRecords, RandomAccess)
+{
+	mapped_records records{ path, sizeof(std::int32_t) };
+	ASSERT_EQ(values.size(), records.size());
+	EXPECT_EQ(static_cast<std::ptrdiff_t>(values.size()), records.end() - records.begin());
+
+	std::size_t i = 0;
+	for (auto record : records)
+		EXPECT_EQ(values[i++], record.as<std::int32_t>());
+	EXPECT_EQ(values[3], records[3].as<std::int32_t>());
+	EXPECT_EQ(values[4], records.begin()[4].as<std::int32_t>());
+}
+
+
+TEST_F(MappedRecords, Combinations)
+{
+	mapped_records records{ path, sizeof(std::int32_t) };
+	mapped_combinations pairs{ records, 2 };
+	EXPECT_EQ(15u, pairs.size());
+
+	std::vector<std::vector<std::int32_t>> expected;
+	for (std::size_t i = 0; i < values.size(); ++i)
+		for (std::size_t j = i + 1; j < values.size(); ++j)
+			expected.push_back({ values[i], values[j] });
+
+	std::vector<std::vector<std::int32_t>> actual;
+	for (auto const& pair : pairs)
+	{
+		std::vector<std::int32_t> contents;
+		for (auto record : pair)
+		{
+			// Subsets refer to the records in place.
+			EXPECT_GE(record.data(), records.data());
+			EXPECT_LT(record.data(), records.data() + records.size() * records.record_size());
+			contents.push_back(record.as<std::int32_t>());
+		}
+		actual.push_back(contents);
+	}
+	EXPECT_EQ(expected, actual);
+
+	EXPECT_EQ(pairs, (mapped_combinations{ records.begin(), records.end(), 2 }));
+}
+
+
+TEST_F(MappedRecords, PowerSet)
+{
+	mapped_records records{ path, sizeof(std::int32_t) };
+	mapped_powerset power{ records };
+	EXPECT_EQ(64u, power.size());
+
+	std::size_t count = 0;
+	for (auto i = power.cbegin(); i != power.cend(); ++i)
+		++count;
+	EXPECT_EQ(64u, count);
+}
+
+
+TEST_F(MappedRecords, SameMappingShortcut)
+{
+	mapped_records records{ path, sizeof(std::int32_t) };
+	mapped_records other{ path, sizeof(std::int32_t) };
+
+	// Views of the same mapping are recognised as the same source without reading it.
+	EXPECT_TRUE(power_iterator_detail::same_element(records.begin(), records.cbegin()));
+	EXPECT_FALSE(power_iterator_detail::same_element(records.begin(), other.begin()));
+	EXPECT_FALSE(power_iterator_detail::same_element(records.begin(), records.begin() + 1));
+
+	EXPECT_EQ(std::hash<record_view>{}(records[2]), std::hash<record_view>{}(records.begin()[2]));
+	EXPECT_NE(power_iterator_detail::fingerprint(records.begin(), records.end()),
+		power_iterator_detail::fingerprint(other.begin(), other.end()));
+
+	EXPECT_EQ((mapped_combinations{ records, 3 }), (mapped_combinations{ records, 3 }));
+	EXPECT_NE((mapped_combinations{ records, 3 }), (mapped_combinations{ other, 3 }));
+	EXPECT_EQ(mapped_powerset{ records }, mapped_powerset{ records });
+	EXPECT_NE(mapped_powerset{ records }, mapped_powerset{ other });
+}
+
+
+TEST_F(MappedRecords, Errors)
+{
+	EXPECT_THROW((mapped_records{ path, 0 }), std::invalid_argument);
+	EXPECT_THROW((mapped_records{ path, 5 }), std::invalid_argument);
+	EXPECT_THROW((mapped_records{ "no/such/file.bin", 4 }), std::system_error);
+}
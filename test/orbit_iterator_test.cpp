@@ -0,0 +1,167 @@
+/**
+*	\author    John Szwast
+*	\year      2014-2016
+*	\copyright MIT
+*/
+
+
+#include "gtest/gtest.h"
+#include "orbit_iterator.hpp"
+#include "combination_iterator.hpp"
+#include <cstdint>
+#include <set>
+#include <string>
+#include <vector>
+
+
+TEST(OrbitCombinations, InterchangeableClasses)
+{
+	// Three interchangeable machines, two interchangeable robots and one crane.
+	std::set<std::string> s{ "crane", "machine1", "machine2", "machine3", "robot1", "robot2" };
+	auto group = symmetry_group::interchangeable(s.size(), { { 1, 2, 3 }, { 4, 5 } });
+	orbit_combinations<std::string> test{ s, 2, group };
+
+	std::vector<std::set<std::string>> expected{
+		{ "crane", "machine1" },
+		{ "crane", "robot1" },
+		{ "machine1", "machine2" },
+		{ "machine1", "robot1" },
+		{ "robot1", "robot2" } };
+	std::vector<std::uint64_t> expected_multiplicities{ 3, 2, 3, 6, 1 };
+
+	std::vector<std::set<std::string>> actual;
+	std::vector<std::uint64_t> multiplicities;
+	for (auto i = test.begin(); i != test.end(); ++i)
+	{
+		actual.push_back(*i);
+		multiplicities.push_back(i.multiplicity());
+	}
+	EXPECT_EQ(expected, actual);
+	EXPECT_EQ(expected_multiplicities, multiplicities);
+}
+
+
+TEST(OrbitCombinations, InterleavedClasses)
+{
+	std::set<int> s{ 0, 1, 2, 3, 4, 5, 6 };
+	auto group = symmetry_group::interchangeable(s.size(), { { 0, 2, 4 }, { 1, 3, 5, 6 } });
+
+	for (std::size_t r = 0; r <= s.size(); ++r)
+	{
+		orbit_combinations<int> test{ s, r, group };
+		std::uint64_t total = 0;
+		std::size_t orbits = 0;
+		for (auto i = test.begin(); i != test.end(); ++i, ++orbits)
+			total += i.multiplicity();
+		EXPECT_EQ(combinations<int>(s, r).size(), total);
+		// One orbit per split of r between classes of 3 and 4.
+		std::size_t splits = 0;
+		for (std::size_t a = 0; a <= 3; ++a)
+			if ((r >= a) && (r - a <= 4))
+				++splits;
+		EXPECT_EQ(splits, orbits);
+	}
+}
+
+
+TEST(OrbitCombinations, CanonicalTests)
+{
+	auto group = symmetry_group::interchangeable(7, { { 0, 2, 4 }, { 1, 3, 5, 6 } });
+	EXPECT_TRUE(group.is_canonical({ 0, 1, 2, 3 }));
+	EXPECT_FALSE(group.is_canonical({ 0, 1, 4 }));
+	EXPECT_FALSE(group.is_canonical({ 2, 3 }));
+	EXPECT_TRUE(group.extends_canonical({ 0, 1, 3 }));
+	EXPECT_FALSE(group.extends_canonical({ 0, 1, 5 }));
+	// Orbit sizes count the members chosen from each class, canonical or not.
+	EXPECT_EQ(3u * 6u, group.orbit_size({ 0, 1, 2, 3 }));
+	EXPECT_EQ(3u * 6u, group.orbit_size({ 2, 4, 5, 6 }));
+}
+
+
+TEST(OrbitCombinations, LargeClass)
+{
+	std::set<int> s;
+	for (int i = 0; i < 20000; ++i)
+		s.insert(i);
+	std::vector<std::size_t> everything(s.size());
+	for (std::size_t i = 0; i < everything.size(); ++i)
+		everything[i] = i;
+	orbit_combinations<int> test{ s, 3, symmetry_group::interchangeable(s.size(), { everything }) };
+
+	auto i = test.begin();
+	ASSERT_NE(test.end(), i);
+	EXPECT_EQ((std::set<int>{ 0, 1, 2 }), *i);
+	EXPECT_EQ(20000ull * 19999 * 19998 / 6, i.multiplicity());
+	EXPECT_EQ(test.end(), ++i);
+}
+
+
+TEST(OrbitCombinations, GeneratedGroup)
+{
+	// The corners of a square under rotation and reflection.
+	std::set<int> s{ 0, 1, 2, 3 };
+	auto group = symmetry_group::generated_by(4, { { 1, 2, 3, 0 }, { 3, 2, 1, 0 } });
+	orbit_combinations<int> test{ s, 2, group };
+
+	std::vector<std::set<int>> actual;
+	std::vector<std::uint64_t> multiplicities;
+	for (auto i = test.begin(); i != test.end(); ++i)
+	{
+		actual.push_back(*i);
+		multiplicities.push_back(i.multiplicity());
+	}
+	EXPECT_EQ((std::vector<std::set<int>>{ { 0, 1 }, { 0, 2 } }), actual);
+	EXPECT_EQ((std::vector<std::uint64_t>{ 4, 2 }), multiplicities);
+}
+
+
+TEST(OrbitCombinations, GeneratedGroupCoversAllCombinations)
+{
+	// A hexagon under rotation only.
+	std::set<int> s{ 0, 1, 2, 3, 4, 5 };
+	auto group = symmetry_group::generated_by(6, { { 1, 2, 3, 4, 5, 0 } });
+
+	for (std::size_t r = 0; r <= s.size(); ++r)
+	{
+		orbit_combinations<int> test{ s.begin(), s.end(), r, group };
+		std::uint64_t total = 0;
+		for (auto i = test.begin(); i != test.end(); ++i)
+			total += i.multiplicity();
+		EXPECT_EQ(combinations<int>(s, r).size(), total);
+	}
+}
+
+
+TEST(OrbitCombinations, ClassesMatchTheirGenerators)
+{
+	std::set<int> s{ 0, 1, 2, 3, 4, 5 };
+	auto classes = symmetry_group::interchangeable(6, { { 0, 3, 5 }, { 1, 4 } });
+	// Transpositions generating the same group.
+	auto generated = symmetry_group::generated_by(6, {
+		{ 3, 1, 2, 0, 4, 5 }, { 0, 1, 2, 5, 4, 3 }, { 0, 4, 2, 3, 1, 5 } });
+
+	for (std::size_t r = 0; r <= s.size(); ++r)
+	{
+		orbit_combinations<int> by_class{ s, r, classes };
+		orbit_combinations<int> by_generator{ s, r, generated };
+		auto i = by_class.begin();
+		auto j = by_generator.begin();
+		for (; (i != by_class.end()) && (j != by_generator.end()); ++i, ++j)
+		{
+			EXPECT_EQ(*i, *j);
+			EXPECT_EQ(i.multiplicity(), j.multiplicity());
+		}
+		EXPECT_EQ(by_class.end(), i);
+		EXPECT_EQ(by_generator.end(), j);
+	}
+}
+
+
+TEST(OrbitCombinations, InvalidGroups)
+{
+	EXPECT_THROW(symmetry_group::interchangeable(3, { { 0, 1 }, { 1, 2 } }), std::invalid_argument);
+	EXPECT_THROW(symmetry_group::generated_by(3, { { 0, 0, 1 } }), std::invalid_argument);
+
+	std::set<int> s{ 0, 1, 2 };
+	EXPECT_THROW((orbit_combinations<int>{ s, 2, symmetry_group::interchangeable(4, {}) }), std::invalid_argument);
+}
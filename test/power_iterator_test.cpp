@@ -156,3 +156,18 @@ TEST(PowerSetIteratorNavigation, PowerSetOfTriple)
     test.cbegin(), test.cend()));
 }
 
+
+TEST(PowerSetIteratorNavigation, IteratorEquality)
+{
+  std::set<int> s{ 0, 1, 2, 3 };
+  powerset<int> test{ s };
+
+  auto lagging = test.cbegin();
+  for (auto leading = test.cbegin(); leading != test.cend(); ++leading, ++lagging)
+  {
+    EXPECT_EQ(leading, lagging);
+    auto ahead = leading;
+    EXPECT_NE(++ahead, lagging);
+  }
+  EXPECT_EQ(test.cend(), lagging);
+}
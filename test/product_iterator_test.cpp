@@ -0,0 +1,120 @@
+/**
+*	\author    John Szwast
+*	\year      2014-2016
+*	\copyright MIT
+*/
+
+
+#include "gtest/gtest.h"
+#include "product_iterator.hpp"
+#include "combination_iterator.hpp"
+#include "power_iterator.hpp"
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+
+TEST(ProductConstruction, MakeProduct)
+{
+	std::set<int> s{ 1, 2, 3 };
+	std::vector<char> v{ 'a', 'b' };
+	auto test = make_product(s, v);
+	EXPECT_EQ(6u, test.size());
+	EXPECT_NE(test.begin(), test.end());
+}
+
+
+TEST(ProductIteratorNavigation, OdometerOrder)
+{
+	std::set<int> s{ 1, 2, 3 };
+	std::vector<char> v{ 'a', 'b' };
+	std::vector<std::tuple<int, char>> expected{
+		{ 1, 'a' }, { 1, 'b' }, { 2, 'a' }, { 2, 'b' }, { 3, 'a' }, { 3, 'b' } };
+
+	std::vector<std::tuple<int, char>> actual;
+	for (auto const& pair : make_product(s, v))
+		actual.emplace_back(std::get<0>(pair), std::get<1>(pair));
+	EXPECT_EQ(expected, actual);
+}
+
+
+TEST(ProductIteratorNavigation, EmptyDimension)
+{
+	std::set<int> s{ 1, 2, 3 };
+	std::vector<char> v;
+	auto test = make_product(s, v);
+	EXPECT_EQ(0u, test.size());
+	EXPECT_EQ(test.begin(), test.end());
+
+	// The size is 0 even when the other dimensions alone would overflow.
+	std::vector<char> big(std::size_t{ 1 } << 20);
+	auto huge = make_product(big, big, big, big, v);
+	EXPECT_EQ(0u, huge.size());
+	EXPECT_EQ(huge.begin(), huge.end());
+}
+
+
+TEST(ProductIteratorNavigation, RankAndUnrank)
+{
+	std::set<int> s{ 1, 2, 3, 4 };
+	std::vector<std::string> v{ "x", "y", "z" };
+	std::set<char> w{ 'p', 'q' };
+	auto test = make_product(s, v, w);
+	ASSERT_EQ(24u, test.size());
+
+	std::size_t rank = 0;
+	for (auto i = test.begin(); i != test.end(); ++i, ++rank)
+	{
+		EXPECT_EQ(rank, i.rank());
+		auto j = test.at(rank);
+		EXPECT_EQ(i, j);
+		EXPECT_EQ(*i, *j);
+	}
+	EXPECT_EQ(test.end(), test.at(test.size()));
+	EXPECT_THROW(test.at(test.size() + 1), std::out_of_range);
+}
+
+
+TEST(ProductIteratorNavigation, CombinationsAndPowerSetDimensions)
+{
+	std::set<int> s{ 0, 1, 2, 3 };
+	std::set<int> t{ 7, 8 };
+
+	auto test = make_product(combinations<int>(s, 2), powerset<int>(t), t);
+	EXPECT_EQ(6u * 4u * 2u, test.size());
+
+	std::size_t count = 0;
+	std::set<std::tuple<std::set<int>, std::set<int>, int>> distinct;
+	for (auto const& triple : test)
+	{
+		EXPECT_EQ(2u, std::get<0>(triple).size());
+		distinct.emplace(std::get<0>(triple), std::get<1>(triple), std::get<2>(triple));
+		++count;
+	}
+	EXPECT_EQ(test.size(), count);
+	EXPECT_EQ(test.size(), distinct.size());
+
+	auto last = test.at(test.size() - 1);
+	EXPECT_EQ((std::set<int>{ 2, 3 }), std::get<0>(*last));
+	EXPECT_EQ(8, std::get<2>(*last));
+}
+
+
+TEST(ProductIteratorNavigation, StoredValues)
+{
+	std::set<int> s{ 0, 1, 2, 3 };
+	std::set<int> t{ 7, 8 };
+
+	auto test = make_product(combinations<int>(s, 2), t);
+	using value_type = decltype(test)::const_iterator::value_type;
+	std::vector<value_type> stored(test.begin(), test.end());
+	ASSERT_EQ(test.size(), stored.size());
+
+	std::size_t members = 0;
+	for (auto const& pair : stored)
+		members += std::get<0>(pair).size();
+	EXPECT_EQ(2u * test.size(), members);
+	EXPECT_EQ((std::set<int>{ 0, 1 }), std::get<0>(stored.front()));
+	EXPECT_EQ(8, std::get<1>(stored.back()));
+}
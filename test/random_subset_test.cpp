@@ -0,0 +1,209 @@
+/**
+*	\author    John Szwast
+*	\year      2014-2016
+*	\copyright MIT
+*/
+
+
+#include "gtest/gtest.h"
+#include "random_subset.hpp"
+#include <cstdint>
+#include <map>
+#include <random>
+#include <set>
+#include <vector>
+
+
+TEST(CombinationSampler, SamplesAreCombinations)
+{
+	std::set<int> s{ 2, 3, 5, 7, 11, 13 };
+	combination_sampler<int> sampler{ s, 3 };
+	std::mt19937_64 g{ 42 };
+
+	for (int i = 0; i < 100; ++i)
+	{
+		auto sample = sampler(g);
+		EXPECT_EQ(3u, sample.size());
+		EXPECT_TRUE(std::includes(s.begin(), s.end(), sample.begin(), sample.end()));
+	}
+}
+
+
+TEST(CombinationSampler, Uniform)
+{
+	std::set<int> s{ 0, 1, 2, 3, 4 };
+	combination_sampler<int> sampler{ s.begin(), s.end(), 2 };
+	std::mt19937_64 g{ 7 };
+
+	std::size_t const draws = 100000;
+	std::vector<std::size_t> indices;
+	sampler.fill_indices(g, draws, std::back_inserter(indices));
+	ASSERT_EQ(2 * draws, indices.size());
+
+	std::map<std::pair<std::size_t, std::size_t>, std::size_t> counts;
+	for (std::size_t i = 0; i < indices.size(); i += 2)
+	{
+		ASSERT_LT(indices[i], indices[i + 1]);
+		++counts[{ indices[i], indices[i + 1] }];
+	}
+
+	EXPECT_EQ(10u, counts.size());
+	for (auto const& count : counts)
+	{
+		EXPECT_GT(count.second, draws / 10 * 9 / 10);
+		EXPECT_LT(count.second, draws / 10 * 11 / 10);
+	}
+}
+
+
+namespace
+{
+
+	/// Uniform over [0, 6 * 10^9]: neither 32 nor 64 bits wide.
+	class odd_range_engine
+	{
+	public:
+		using result_type = std::uint64_t;
+
+		static constexpr result_type min()
+		{
+			return 0;
+		}
+
+		static constexpr result_type max()
+		{
+			return 6000000000u;
+		}
+
+		result_type operator()()
+		{
+			result_type x;
+			do
+				x = m_engine() >> 31;
+			while (x > max());
+			return x;
+		}
+
+	private:
+		std::mt19937_64 m_engine{ 11 };
+	};
+
+}
+
+
+TEST(CombinationSampler, OddRangeGenerator)
+{
+	odd_range_engine g;
+	std::size_t const draws = 90000;
+	std::vector<std::size_t> counts(3);
+	for (std::size_t i = 0; i < draws; ++i)
+		++counts[power_iterator_detail::uniform_below(g, std::size_t{ 3 })];
+	for (auto count : counts)
+	{
+		EXPECT_GT(count, draws / 3 * 9 / 10);
+		EXPECT_LT(count, draws / 3 * 11 / 10);
+	}
+}
+
+
+TEST(CombinationSampler, NarrowGenerator)
+{
+	std::set<int> s{ 0, 1, 2 };
+	combination_sampler<int> sampler{ s.begin(), s.end(), 1 };
+	std::independent_bits_engine<std::mt19937, 16, std::uint16_t> g{ 3 };
+
+	std::size_t const draws = 90000;
+	std::vector<std::size_t> indices;
+	sampler.fill_indices(g, draws, std::back_inserter(indices));
+	std::vector<std::size_t> counts(3);
+	for (auto i : indices)
+		++counts[i];
+	for (auto count : counts)
+	{
+		EXPECT_GT(count, draws / 3 * 9 / 10);
+		EXPECT_LT(count, draws / 3 * 11 / 10);
+	}
+}
+
+
+TEST(CombinationSampler, WithoutReplacement)
+{
+	std::set<int> s{ 0, 1, 2, 3, 4 };
+	combination_sampler<int> sampler{ s, 3 };
+	std::mt19937 g{ 1 };
+
+	std::vector<std::set<int>> samples;
+	sampler.fill(g, 10, std::back_inserter(samples), sampling::without_replacement);
+	EXPECT_EQ(10u, std::set<std::set<int>>(samples.begin(), samples.end()).size());
+
+	EXPECT_THROW(sampler.fill(g, 11, std::back_inserter(samples), sampling::without_replacement),
+		std::invalid_argument);
+}
+
+
+TEST(CombinationSampler, RejectsOversizedR)
+{
+	std::set<int> s{ 0, 1 };
+	EXPECT_THROW((combination_sampler<int>{ s, 3 }), std::invalid_argument);
+}
+
+
+TEST(CombinationSampler, EmptyCombinations)
+{
+	std::set<int> s{ 0, 1, 2 };
+	combination_sampler<int> sampler{ s, 0 };
+	std::mt19937 g{ 1 };
+	EXPECT_TRUE(sampler(g).empty());
+
+	std::vector<std::set<int>> samples;
+	sampler.fill(g, 5, std::back_inserter(samples));
+	EXPECT_EQ(std::vector<std::set<int>>(5), samples);
+
+	samples.clear();
+	sampler.fill(g, 1, std::back_inserter(samples), sampling::without_replacement);
+	EXPECT_EQ(1u, samples.size());
+	EXPECT_THROW(sampler.fill(g, 2, std::back_inserter(samples), sampling::without_replacement),
+		std::invalid_argument);
+}
+
+
+TEST(SubsetSampler, Uniform)
+{
+	std::set<int> s{ 10, 20, 30 };
+	subset_sampler<int> sampler{ s };
+	std::mt19937_64 g{ 3 };
+
+	std::size_t const draws = 80000;
+	std::vector<std::uint64_t> masks;
+	sampler.fill_masks(g, draws, std::back_inserter(masks));
+
+	std::vector<std::size_t> counts(8);
+	for (auto mask : masks)
+	{
+		ASSERT_LT(mask, 8u);
+		++counts[mask];
+	}
+	for (auto count : counts)
+	{
+		EXPECT_GT(count, draws / 8 * 9 / 10);
+		EXPECT_LT(count, draws / 8 * 11 / 10);
+	}
+
+	auto sample = sampler(g);
+	EXPECT_TRUE(std::includes(s.begin(), s.end(), sample.begin(), sample.end()));
+}
+
+
+TEST(SubsetSampler, WithoutReplacement)
+{
+	std::set<int> s{ 1, 2, 3, 4 };
+	subset_sampler<int> sampler{ s.begin(), s.end() };
+	std::mt19937 g{ 5 };
+
+	std::vector<std::uint64_t> masks;
+	sampler.fill_masks(g, 16, std::back_inserter(masks), sampling::without_replacement);
+	EXPECT_EQ(16u, std::set<std::uint64_t>(masks.begin(), masks.end()).size());
+
+	EXPECT_THROW(sampler.fill_masks(g, 17, std::back_inserter(masks), sampling::without_replacement),
+		std::invalid_argument);
+}
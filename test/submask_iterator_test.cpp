@@ -0,0 +1,97 @@
+/**
+*	\author    John Szwast
+*	\year      2014-2016
+*	\copyright MIT
+*/
+
+
+#include "gtest/gtest.h"
+#include "submask_iterator.hpp"
+#include "power_iterator.hpp"
+#include <set>
+#include <vector>
+
+
+TEST(Submasks, EnumeratesEverySubmask)
+{
+	subset_mask const mask = 0x2d;	// 101101
+	auto view = submasks_of(mask);
+	EXPECT_EQ(16u, view.size());
+
+	std::vector<subset_mask> actual(view.begin(), view.end());
+	ASSERT_EQ(16u, actual.size());
+	EXPECT_EQ(mask, actual.front());
+	EXPECT_EQ(0u, actual.back());
+	for (auto sub : actual)
+		EXPECT_EQ(sub, sub & mask);
+	EXPECT_EQ(16u, std::set<subset_mask>(actual.begin(), actual.end()).size());
+}
+
+
+TEST(Submasks, EmptyMask)
+{
+	auto view = submasks_of(0);
+	EXPECT_EQ(1u, view.size());
+	std::vector<subset_mask> actual(view.begin(), view.end());
+	EXPECT_EQ(std::vector<subset_mask>{ 0 }, actual);
+}
+
+
+TEST(Supersets, EnumeratesEverySuperset)
+{
+	subset_mask const mask = 0x5;	// 00101 of 5 elements
+	auto view = supersets_of(mask, 5);
+	EXPECT_EQ(8u, view.size());
+
+	std::vector<subset_mask> actual(view.begin(), view.end());
+	ASSERT_EQ(8u, actual.size());
+	EXPECT_EQ(mask, actual.front());
+	EXPECT_EQ(0x1fu, actual.back());
+	for (auto super : actual)
+	{
+		EXPECT_EQ(mask, super & mask);
+		EXPECT_EQ(0u, super & ~subset_mask{ 0x1f });
+	}
+	EXPECT_EQ(8u, std::set<subset_mask>(actual.begin(), actual.end()).size());
+}
+
+
+TEST(Supersets, FullWidth)
+{
+	auto view = supersets_of(~subset_mask{ 1 }, 64);
+	EXPECT_EQ(2u, view.size());
+	std::vector<subset_mask> actual(view.begin(), view.end());
+	EXPECT_EQ((std::vector<subset_mask>{ ~subset_mask{ 1 }, ~subset_mask{ 0 } }), actual);
+
+	EXPECT_THROW(supersets_of(0x40, 6), std::invalid_argument);
+	EXPECT_THROW(supersets_of(0, 65), std::length_error);
+	EXPECT_THROW(supersets_of(0, 64).size(), std::overflow_error);
+}
+
+
+TEST(Submasks, PowerSetMasks)
+{
+	std::set<int> s{ 3, 5, 8, 13, 21 };
+	powerset<int> power{ s };
+
+	std::set<int> subset{ 5, 13 };
+	auto mask = power.mask_of(subset);
+	EXPECT_EQ(0xau, mask);
+	EXPECT_EQ(subset, power.subset_of(mask));
+	EXPECT_THROW(power.mask_of(std::set<int>{ 5, 6 }), std::invalid_argument);
+
+	std::set<std::set<int>> expected{ {}, { 5 }, { 13 }, { 5, 13 } };
+	std::set<std::set<int>> actual;
+	for (auto sub : submasks_of(mask))
+		actual.insert(power.subset_of(sub));
+	EXPECT_EQ(expected, actual);
+
+	std::size_t count = 0;
+	for (auto super : supersets_of(mask, s.size()))
+	{
+		auto superset = power.subset_of(super);
+		EXPECT_TRUE(std::includes(superset.begin(), superset.end(), subset.begin(), subset.end()));
+		++count;
+	}
+	EXPECT_EQ(8u, count);
+}
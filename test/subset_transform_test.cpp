@@ -0,0 +1,118 @@
+/**
+*	\author    John Szwast
+*	\year      2014-2016
+*	\copyright MIT
+*/
+
+
+#include "gtest/gtest.h"
+#include "subset_transform.hpp"
+#include <cstdint>
+#include <vector>
+
+
+namespace
+{
+	std::vector<std::int64_t> sample_values(unsigned n)
+	{
+		std::vector<std::int64_t> values(std::size_t{ 1 } << n);
+		for (std::size_t mask = 0; mask < values.size(); ++mask)
+			values[mask] = static_cast<std::int64_t>((mask * 2654435761u) % 1000) - 500;
+		return values;
+	}
+
+	std::vector<std::int64_t> brute_force_subset_sums(std::vector<std::int64_t> const& values)
+	{
+		std::vector<std::int64_t> sums(values.size());
+		for (std::size_t mask = 0; mask < values.size(); ++mask)
+		{
+			// Visit every submask of mask, including 0.
+			for (std::size_t sub = mask; ; sub = (sub - 1) & mask)
+			{
+				sums[mask] += values[sub];
+				if (sub == 0)
+					break;
+			}
+		}
+		return sums;
+	}
+}
+
+
+TEST(SubsetTransform, ZetaMatchesBruteForce)
+{
+	auto values = sample_values(10);
+	auto expected = brute_force_subset_sums(values);
+	zeta_transform(values);
+	EXPECT_EQ(expected, values);
+}
+
+
+TEST(SubsetTransform, SupersetZeta)
+{
+	unsigned const n = 8;
+	auto values = sample_values(n);
+	std::size_t const full = (std::size_t{ 1 } << n) - 1;
+
+	// Superset sums are subset sums over complemented masks.
+	std::vector<std::int64_t> complemented(values.size());
+	for (std::size_t mask = 0; mask < values.size(); ++mask)
+		complemented[full ^ mask] = values[mask];
+	auto subset_sums = brute_force_subset_sums(complemented);
+
+	zeta_transform(values, lattice_direction::supersets);
+	for (std::size_t mask = 0; mask < values.size(); ++mask)
+		EXPECT_EQ(subset_sums[full ^ mask], values[mask]);
+}
+
+
+TEST(SubsetTransform, MobiusInvertsZetaAcrossThreads)
+{
+	for (unsigned threads : { 1u, 4u })
+		for (auto direction : { lattice_direction::subsets, lattice_direction::supersets })
+		{
+			auto const original = sample_values(18);
+			auto values = original;
+			zeta_transform(values, direction, threads);
+			EXPECT_NE(original, values);
+			mobius_transform(values, direction, threads);
+			EXPECT_EQ(original, values);
+		}
+}
+
+
+TEST(SubsetTransform, MinAndOrSemirings)
+{
+	auto values = sample_values(16);
+	auto minima = values;
+	zeta_transform<min_semiring>(minima, lattice_direction::subsets, 3);
+
+	std::vector<std::uint32_t> bits(values.size());
+	for (std::size_t mask = 0; mask < bits.size(); ++mask)
+		bits[mask] = std::uint32_t{ 1 } << (mask % 32);
+	auto ors = bits;
+	zeta_transform<or_semiring>(ors);
+
+	// Spot-check against direct enumeration of the submasks.
+	for (std::size_t mask : { std::size_t{ 0 }, std::size_t{ 0x5a5a }, std::size_t{ 0xffff } })
+	{
+		auto least = values[mask];
+		std::uint32_t any = 0;
+		for (std::size_t sub = mask; ; sub = (sub - 1) & mask)
+		{
+			least = std::min(least, values[sub]);
+			any |= bits[sub];
+			if (sub == 0)
+				break;
+		}
+		EXPECT_EQ(least, minima[mask]);
+		EXPECT_EQ(any, ors[mask]);
+	}
+}
+
+
+TEST(SubsetTransform, RejectsNonPowerOfTwoSize)
+{
+	std::vector<int> values(12);
+	EXPECT_THROW(zeta_transform(values), std::invalid_argument);
+}